@@ -0,0 +1,59 @@
+#include "orderbook/AsyncOrderbook.h"
+#include "shared/Timer.h"
+
+#include <iostream>
+
+// 10k strategies, each a coroutine submitting 20 orders one after another on one executor
+// thread, against the same orders submitted by a plain loop. The difference is the cost
+// of suspending, queueing and resuming a strategy per order.
+namespace {
+    constexpr std::size_t strategies = 10'000;
+    constexpr std::size_t rounds = 20;
+
+    // Orders cluster around 1000 so roughly half of them trade.
+    Order orderFor(std::size_t strategy, std::size_t round) {
+        const auto id = static_cast<OrderId>(round * strategies + strategy);
+        const auto offset = static_cast<Price>((id * 2654435761u) % 21) - 10;
+        const bool buy = (strategy + round) % 2 == 0;
+        return {id, OrderType::GoodTillCancel, buy ? Side::Buy : Side::Sell, 1000 + offset, 1 + id % 9};
+    }
+
+    AsyncTask strategy(AsyncOrderbook &async, std::size_t index, Quantity &filled) {
+        for (std::size_t round = 0; round < rounds; ++round) {
+            filled += (co_await async.submit(orderFor(index, round))).filled;
+        }
+    }
+
+    double direct(Quantity &filled) {
+        Orderbook ob{false};
+        Timer timer;
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (std::size_t s = 0; s < strategies; ++s) filled += ob.submit(orderFor(s, round)).filled;
+        }
+        return timer.elapsed();
+    }
+
+    double async(Quantity &filled) {
+        Orderbook ob{false};
+        AsyncOrderbook executor{ob};
+        std::vector<Quantity> perStrategy(strategies, 0);
+        Timer timer;
+        for (std::size_t s = 0; s < strategies; ++s) executor.spawn(strategy(executor, s, perStrategy[s]));
+        executor.waitIdle();
+        const double seconds = timer.elapsed();
+        for (const Quantity q: perStrategy) filled += q;
+        return seconds;
+    }
+}
+
+int main() {
+    Quantity directFilled = 0;
+    Quantity asyncFilled = 0;
+    const double directSeconds = direct(directFilled);
+    const double asyncSeconds = async(asyncFilled);
+
+    constexpr double submits = strategies * rounds;
+    std::cout << "\n" << strategies << " strategies x " << rounds << " orders\n";
+    std::cout << "Direct submit: " << directSeconds / submits * 1e9 << "ns/order, filled " << directFilled << "\n";
+    std::cout << "co_await submit: " << asyncSeconds / submits * 1e9 << "ns/order, filled " << asyncFilled << "\n";
+}
@@ -0,0 +1,79 @@
+#include "orderbook/Orderbook.h"
+#include "orderbook/LevelKernels.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Collects 1M orders in auction mode with overlapping bid and ask distributions, then times the
+// clearing price computation on its own and the full uncross including the allocation pass.
+namespace {
+    constexpr std::size_t orders = 1'000'000;
+    constexpr Price mid = 30'000;
+
+    struct UncrossTiming {
+        double clearingSeconds;
+        double uncrossSeconds;
+    };
+
+    UncrossTiming uncrossOnce(std::size_t &trades, AuctionResult &result) {
+        Orderbook ob{false};
+        PhiloxStream rng{7, 0, 0};
+        ob.openAuction();
+        for (std::size_t i = 0; i < orders; ++i) {
+            const bool buy = i % 2 == 0;
+            // Bids centred above mid and asks below, so the books overlap over a few hundred ticks.
+            const double centre = buy ? mid + 50 : mid - 50;
+            const auto price = static_cast<Price>(std::lround(centre + 400 * rng.normal()));
+            ob.addOrder({
+                static_cast<OrderId>(i), OrderType::GoodTillCancel, buy ? Side::Buy : Side::Sell,
+                std::clamp<Price>(price, 1, Constants::LEVELARRAY_SIZE - 1), 1 + rng.below(100)
+            });
+        }
+
+        Timer timer;
+        const auto indicative = ob.indicativeUncross();
+        const double clearingSeconds = timer.elapsed();
+
+        timer.start();
+        result = *ob.uncross();
+        const double uncrossSeconds = timer.elapsed();
+        trades = ob.getTrades().size();
+        if (indicative->price != result.price) std::cerr << "indicative price differs from uncross\n";
+        return {clearingSeconds, uncrossSeconds};
+    }
+
+    double prefixSumNs(void (*kernel)(const Quantity *, Quantity *, std::size_t), std::vector<Quantity> &buffer) {
+        constexpr int repeats = 2'000;
+        std::vector<Quantity> out(buffer.size());
+        const Timer timer;
+        for (int r = 0; r < repeats; ++r) kernel(buffer.data(), out.data(), buffer.size());
+        const double seconds = timer.elapsed();
+        buffer[0] = out.back(); // keep the result live
+        return seconds / repeats * 1e9;
+    }
+}
+
+int main() {
+    std::size_t trades = 0;
+    AuctionResult result{};
+    const auto [clearingSeconds, uncrossSeconds] = uncrossOnce(trades, result);
+
+    std::vector<Quantity> levels(Constants::LEVELARRAY_SIZE);
+    for (std::size_t i = 0; i < levels.size(); ++i) levels[i] = i % 97;
+
+    std::cout << "\nUncross of " << orders << " orders: price " << result.price << ", volume " << result.volume
+            << ", surplus " << result.surplus << '\n';
+    std::cout << "Clearing price: " << clearingSeconds * 1e6 << "us, full uncross (" << trades << " trades): "
+            << uncrossSeconds * 1e3 << "ms\n";
+    std::cout << "Prefix sum over " << levels.size() << " levels:";
+    for (const auto isa: {LevelKernels::Isa::Scalar, LevelKernels::Isa::Avx2, LevelKernels::Isa::Avx512}) {
+        if (!LevelKernels::supported(isa)) continue;
+        std::cout << ' ' << LevelKernels::name(isa) << ' '
+                << prefixSumNs(LevelKernels::kernels(isa).inclusivePrefixSum, levels) << "ns";
+    }
+    std::cout << '\n';
+}
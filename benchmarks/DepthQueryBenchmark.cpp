@@ -0,0 +1,127 @@
+#include "orderbook/Constants.h"
+#include "orderbook/LevelKernels.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Times the three depth queries over one side's level columns: the sum of quantity from best
+// through a price 5000 ticks away, the first level at which the cumulative quantity reaches a
+// target that takes about 2000 ticks, and the best 10 / 100 non-empty levels. Every kernel set
+// the CPU supports is run, plus a scalar walk over 32-byte interleaved slots, the layout the
+// level arrays used before quantities and counts got their own columns.
+namespace {
+    constexpr std::size_t levels = Constants::LEVELARRAY_SIZE;
+    constexpr std::size_t best = 20'000;
+    constexpr int repeats = 20'000;
+
+    struct InterleavedSlot {
+        std::uint64_t fifo[2];
+        Quantity quantity;
+        Quantity count;
+    };
+
+    struct Columns {
+        std::vector<Quantity> quantities = std::vector<Quantity>(levels);
+        std::vector<Quantity> counts = std::vector<Quantity>(levels);
+        std::vector<InterleavedSlot> slots = std::vector<InterleavedSlot>(levels);
+    };
+
+    // One level in eight is populated from best outwards.
+    Columns makeColumns() {
+        Columns c;
+        PhiloxStream rng{11, 0, 0};
+        for (std::size_t i = best; i < levels; ++i) {
+            if (rng.below(8) != 0) continue;
+            c.counts[i] = 1 + rng.below(4);
+            c.quantities[i] = c.counts[i] * (1 + rng.below(100));
+            c.slots[i].quantity = c.quantities[i];
+            c.slots[i].count = c.counts[i];
+        }
+        return c;
+    }
+
+    struct Timings {
+        const char *name;
+        double sumNs;
+        double reachNs;
+        double top10Ns;
+        double top100Ns;
+    };
+
+    template<class F>
+    double timeNs(F &&f) {
+        std::uint64_t sink = 0;
+        const Timer timer;
+        for (int r = 0; r < repeats; ++r) sink += f();
+        const double seconds = timer.elapsed();
+        if (sink == 42) std::cerr << ' '; // keep the results live
+        return seconds / repeats * 1e9;
+    }
+
+    Timings timeKernels(LevelKernels::Isa isa, const Columns &c, Quantity target) {
+        const auto &k = LevelKernels::kernels(isa);
+        const Quantity *q = c.quantities.data() + best;
+        const Quantity *n = c.counts.data() + best;
+        const std::size_t span = levels - best;
+        std::uint32_t out[100];
+        return {
+            LevelKernels::name(isa),
+            timeNs([&] { return k.sum(q, 5'000); }),
+            timeNs([&] { return k.firstCumulativeAtLeast(q, span, target); }),
+            timeNs([&] { return k.firstNonZero(n, span, 10, out) + out[0]; }),
+            timeNs([&] { return k.firstNonZero(n, span, 100, out) + out[0]; })
+        };
+    }
+
+    Timings timeInterleaved(const Columns &c, Quantity target) {
+        const InterleavedSlot *s = c.slots.data() + best;
+        const std::size_t span = levels - best;
+        const auto top = [&](std::size_t limit) {
+            std::size_t found = 0, last = 0;
+            for (std::size_t i = 0; i < span && found < limit; ++i) {
+                if (s[i].count) last = i, ++found;
+            }
+            return found + last;
+        };
+        return {
+            "interleaved",
+            timeNs([&] {
+                Quantity total = 0;
+                for (std::size_t i = 0; i < 5'000; ++i) total += s[i].quantity;
+                return total;
+            }),
+            timeNs([&] {
+                Quantity running = 0;
+                for (std::size_t i = 0; i < span; ++i) {
+                    if ((running += s[i].quantity) >= target) return i;
+                }
+                return span;
+            }),
+            timeNs([&] { return top(10); }),
+            timeNs([&] { return top(100); })
+        };
+    }
+}
+
+int main() {
+    const Columns columns = makeColumns();
+    Quantity target = 0;
+    for (std::size_t i = best; i < best + 2'000; ++i) target += columns.quantities[i];
+
+    std::vector<Timings> results{timeInterleaved(columns, target)};
+    for (const auto isa: {LevelKernels::Isa::Scalar, LevelKernels::Isa::Avx2, LevelKernels::Isa::Avx512}) {
+        if (LevelKernels::supported(isa)) results.push_back(timeKernels(isa, columns, target));
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(13) << "layout/isa" << std::right << std::setw(12) << "sum 5000"
+            << std::setw(12) << "reach ~2000" << std::setw(10) << "top 10" << std::setw(10) << "top 100" << '\n';
+    for (const auto &t: results) {
+        std::cout << std::left << std::setw(13) << t.name << std::right << std::setw(10) << t.sumNs << "ns"
+                << std::setw(10) << t.reachNs << "ns" << std::setw(8) << t.top10Ns << "ns"
+                << std::setw(8) << t.top100Ns << "ns\n";
+    }
+}
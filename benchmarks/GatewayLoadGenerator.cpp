@@ -0,0 +1,163 @@
+#include "gateway/Gateway.h"
+#include "gateway/GatewayClient.h"
+#include "shared/Philox.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/prctl.h>
+
+// Round-trip latency of the order gateway at fixed message rates.
+//
+//   GatewayLoadGenerator [--tcp address:port | --unix path] [--seconds s] [rate ...]
+//
+// Without an endpoint, a gateway is started in this process on an ephemeral TCP port and a Unix
+// socket, and every rate is run over both. Requests are sent open loop on a fixed schedule and
+// stamped with their scheduled time, so a stalled gateway shows up as latency rather than as a
+// lower send rate. A request's round trip ends at the first report that echoes its timestamp.
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct LoadResult {
+        std::uint64_t sent;
+        std::uint64_t answered;
+        std::vector<std::uint64_t> latencies;
+    };
+
+    std::uint64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    // A resting flow around one price: limit orders on both sides that sometimes cross, a few
+    // FAKs, and cancels and modifies of recently sent ids (some already gone, which are rejected).
+    Protocol::Request nextRequest(PhiloxStream &rng, OrderId &nextId, std::uint64_t timestamp) {
+        constexpr Price mid = 1000;
+        const auto side = rng.below(2) == 0 ? Side::Buy : Side::Sell;
+        const auto offset = static_cast<Price>(rng.below(8));
+        const Price price = side == Side::Buy ? mid - 5 + offset : mid + 5 - offset;
+        const auto recent = [&] { return nextId - 1 - rng.below(std::min<OrderId>(nextId, 1000)); };
+
+        const auto roll = rng.below(100);
+        if (nextId > 0 && roll < 25) {
+            return {Protocol::RequestType::CancelOrder, side, OrderType::GoodTillCancel, 0, 0, recent(), 0, timestamp};
+        }
+        if (nextId > 0 && roll < 40) {
+            return {
+                Protocol::RequestType::ModifyOrder, side, OrderType::GoodTillCancel, 0, price, recent(),
+                1 + rng.below(10), timestamp
+            };
+        }
+        const auto type = roll < 45 ? OrderType::FillAndKill : OrderType::GoodTillCancel;
+        return {Protocol::RequestType::NewOrder, side, type, 0, price, nextId++, 1 + rng.below(10), timestamp};
+    }
+
+    LoadResult runLoad(GatewayClient &client, double rate, double seconds) {
+        PhiloxStream rng{42, 0, 0};
+        OrderId nextId = 0;
+        LoadResult result{0, 0, {}};
+        result.latencies.reserve(static_cast<std::size_t>(rate * seconds) + 1);
+
+        std::uint64_t lastTimestamp = 0;
+        const auto onReport = [&](const Protocol::Report &report) {
+            if (report.clientTimestamp <= lastTimestamp) return;
+            lastTimestamp = report.clientTimestamp;
+            result.latencies.push_back(nowNs() - report.clientTimestamp);
+            ++result.answered;
+        };
+
+        const std::uint64_t interval = static_cast<std::uint64_t>(1e9 / rate);
+        const std::uint64_t start = nowNs();
+        const std::uint64_t end = start + static_cast<std::uint64_t>(seconds * 1e9);
+        std::uint64_t due = start;
+        while (due < end) {
+            for (const std::uint64_t now = nowNs(); due <= now && due < end; due += interval, ++result.sent) {
+                client.send(nextRequest(rng, nextId, due));
+            }
+            client.drain(onReport);
+            const std::uint64_t now = nowNs();
+            if (due > now) client.wait(std::chrono::nanoseconds(due - now));
+        }
+
+        const auto deadline = Clock::now() + std::chrono::seconds(1);
+        while (result.answered < result.sent && Clock::now() < deadline) {
+            client.wait(std::chrono::milliseconds(10));
+            client.drain(onReport);
+        }
+        return result;
+    }
+
+    void print(const std::string &transport, double rate, LoadResult &result) {
+        auto &l = result.latencies;
+        std::ranges::sort(l);
+        const auto at = [&](double q) {
+            return l.empty() ? 0.0 : l[std::min(l.size() - 1, static_cast<std::size_t>(q * l.size()))] / 1e3;
+        };
+        std::cout << std::left << std::setw(10) << transport << std::right << std::setw(10)
+                << static_cast<std::uint64_t>(rate)
+                << std::setw(10) << result.sent << std::setw(10) << result.answered << std::fixed
+                << std::setprecision(1) << std::setw(10) << at(0.5) << std::setw(10) << at(0.9)
+                << std::setw(10) << at(0.99) << std::setw(10) << at(0.999) << std::setw(10)
+                << (l.empty() ? 0.0 : l.back() / 1e3) << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string tcp;
+    std::string unixPath;
+    double seconds = 1;
+    std::vector<double> rates;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--tcp" && i + 1 < argc) tcp = argv[++i];
+        else if (arg == "--unix" && i + 1 < argc) unixPath = argv[++i];
+        else if (arg == "--seconds" && i + 1 < argc) seconds = std::stod(argv[++i]);
+        else rates.push_back(std::stod(arg));
+    }
+    if (rates.empty()) rates = {10'000, 50'000, 100'000};
+    // The default 50us timer slack would make every paced send late by up to that much.
+    prctl(PR_SET_TIMERSLACK, 1UL);
+
+    Orderbook book{false};
+    std::unique_ptr<Gateway> gateway;
+    std::atomic<bool> stop{false};
+    std::thread gatewayThread;
+    if (tcp.empty() && unixPath.empty()) {
+        gateway = std::make_unique<Gateway>(book, GatewayOptions{
+                                                .unixPath = "/tmp/orderbook_gateway_loadgen.sock"
+                                            });
+        tcp = "127.0.0.1:" + std::to_string(gateway->tcpPort());
+        unixPath = "/tmp/orderbook_gateway_loadgen.sock";
+        gatewayThread = std::thread{[&] { gateway->run(stop); }};
+    }
+
+    std::cout << "transport   rate/s      sent  answered   p50(us)   p90(us)   p99(us) p99.9(us)   max(us)\n";
+    for (const double rate: rates) {
+        if (!tcp.empty()) {
+            const auto colon = tcp.rfind(':');
+            GatewayClient client = GatewayClient::connectTcp(tcp.substr(0, colon),
+                                                             static_cast<std::uint16_t>(std::stoi(tcp.substr(colon + 1))));
+            LoadResult result = runLoad(client, rate, seconds);
+            print("tcp", rate, result);
+        }
+        if (!unixPath.empty()) {
+            GatewayClient client = GatewayClient::connectUnix(unixPath);
+            LoadResult result = runLoad(client, rate, seconds);
+            print("unix", rate, result);
+        }
+    }
+
+    if (gateway) {
+        stop = true;
+        gatewayThread.join();
+        const GatewayStats stats = gateway->stats();
+        std::cout << "Gateway: " << stats.requests << " requests in " << stats.batches << " batches ("
+                << static_cast<double>(stats.requests) / std::max<std::uint64_t>(stats.batches, 1)
+                << " per batch), " << stats.reports << " reports\n";
+    }
+}
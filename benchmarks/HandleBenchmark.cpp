@@ -0,0 +1,72 @@
+#include "orderbook/Orderbook.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+// Rests 200k orders, then modifies and cancels all of them in a shuffled order, once through the
+// id-based API and once through the handles addOrder returned. Like a strategy's own order
+// records, each order's id and handle are kept side by side, so both runs read the same line.
+namespace {
+    constexpr std::size_t orders = 200'000;
+    constexpr Price mid = 30'000;
+
+    struct Resting {
+        OrderId id;
+        OrderHandle handle;
+    };
+
+    struct Timings {
+        double modifyNs;
+        double cancelNs;
+    };
+
+    Timings run(bool byHandle) {
+        Orderbook ob{false};
+        PhiloxStream rng{5, 0, 0};
+        std::vector<Resting> resting(orders);
+        for (std::size_t i = 0; i < orders; ++i) {
+            const bool buy = i % 2 == 0;
+            const auto offset = static_cast<Price>(1 + rng.below(500));
+            resting[i].id = static_cast<OrderId>(i);
+            resting[i].handle = ob.addOrder({
+                static_cast<OrderId>(i), OrderType::GoodTillCancel, buy ? Side::Buy : Side::Sell,
+                buy ? mid - offset : mid + offset, 1 + rng.below(100)
+            });
+        }
+
+        std::vector<std::size_t> order(orders);
+        for (std::size_t i = 0; i < orders; ++i) order[i] = i;
+        for (std::size_t i = orders - 1; i > 0; --i) std::swap(order[i], order[rng.below(i + 1)]);
+
+        // Move every order one tick away from the touch; nothing crosses.
+        Timer timer;
+        for (const std::size_t i: order) {
+            const bool buy = i % 2 == 0;
+            const Price price = buy ? mid - 600 : mid + 600;
+            auto &[id, handle] = resting[i];
+            if (byHandle) handle = ob.modifyOrder(handle, price, 5);
+            else ob.modifyOrder({id, buy ? Side::Buy : Side::Sell, price, 5});
+        }
+        const double modifySeconds = timer.elapsed();
+
+        timer.start();
+        for (const std::size_t i: order) {
+            if (byHandle) ob.cancelOrder(resting[i].handle);
+            else ob.cancelOrder(resting[i].id);
+        }
+        const double cancelSeconds = timer.elapsed();
+        if (ob.size() != 0) std::cerr << "orders left behind\n";
+        return {modifySeconds / orders * 1e9, cancelSeconds / orders * 1e9};
+    }
+}
+
+int main() {
+    const Timings byId = run(false);
+    const Timings byHandle = run(true);
+
+    std::cout << "\nModify: by id " << byId.modifyNs << "ns, by handle " << byHandle.modifyNs << "ns\n";
+    std::cout << "Cancel: by id " << byId.cancelNs << "ns, by handle " << byHandle.cancelNs << "ns\n";
+}
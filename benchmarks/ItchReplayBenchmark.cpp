@@ -0,0 +1,161 @@
+#include "itch/ItchBookBuilder.h"
+#include "itch/ItchReader.h"
+#include "itch/ItchWriter.h"
+#include "shared/MappedFile.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ItchReplayBenchmark [file] [--symbols AAPL,MSFT,...] [--top n]
+// Maps an uncompressed ITCH 5.0 file, walks it once to count its messages, then rebuilds the books
+// of the chosen stocks (the n with the most adds unless --symbols is given; 32 by default) and
+// reports the rate. Without a file it writes a synthetic one: 16 stocks, 4M book messages.
+namespace {
+    struct Live {
+        std::uint64_t reference;
+        std::uint32_t shares;
+        std::uint32_t price;
+        Side side;
+    };
+
+    // Orders rest around a fixed mid per stock, so the synthetic feed never crosses. The message
+    // mix is roughly a NASDAQ day's: mostly adds and deletes, some replaces, few executions, and
+    // each book holds about 3000 orders.
+    std::string generateFile(std::size_t messages) {
+        constexpr std::uint16_t stocks = 16;
+        PhiloxStream rng{50, 0, 0};
+        ItchWriter writer;
+        writer.systemEvent('O');
+        std::vector<std::string> symbols;
+        std::vector<std::uint32_t> mids;
+        std::vector<std::vector<Live> > live(stocks + 1);
+        for (std::uint16_t locate = 1; locate <= stocks; ++locate) {
+            symbols.push_back("SYM" + std::to_string(locate));
+            mids.push_back(static_cast<std::uint32_t>(2'000 + rng.below(40'000)));
+            writer.stockDirectory(locate, symbols.back());
+        }
+        std::uint64_t nextReference = 1, match = 1;
+        for (std::size_t i = 0; i < messages; ++i) {
+            writer.setTimestamp(34'200'000'000'000 + i * 5'000);
+            const auto locate = static_cast<std::uint16_t>(1 + rng.below(stocks));
+            auto &orders = live[locate];
+            const std::uint32_t mid = mids[locate - 1];
+            const auto newPrice = [&](Side side) {
+                const auto offset = static_cast<std::uint32_t>(1 + rng.below(8) * rng.below(8));
+                return (side == Side::Buy ? mid - offset : mid + offset) * 100;
+            };
+            const std::uint64_t roll = rng.below(100);
+            if (orders.empty() || roll < (orders.size() < 3'000 ? 50u : 40u)) {
+                const Side side = rng.below(2) ? Side::Buy : Side::Sell;
+                const Live order{nextReference++, static_cast<std::uint32_t>(100 * (1 + rng.below(10))), newPrice(side), side};
+                if (roll % 10 == 0)
+                    writer.addOrderWithMpid(locate, order.reference, side, order.shares, symbols[locate - 1],
+                                            order.price, "MPID");
+                else writer.addOrder(locate, order.reference, side, order.shares, symbols[locate - 1], order.price);
+                orders.push_back(order);
+                continue;
+            }
+            // Most orders are short-lived: four in five messages refer to one of the last 64 added.
+            const std::size_t window = rng.below(5) ? std::min<std::size_t>(orders.size(), 64) : orders.size();
+            const std::size_t pick = orders.size() - 1 - rng.below(window);
+            Live &order = orders[pick];
+            if (roll < 88) {
+                writer.orderDelete(locate, order.reference);
+            } else if (roll < 94) {
+                const Live replacement{nextReference++, static_cast<std::uint32_t>(100 * (1 + rng.below(10))),
+                                       newPrice(order.side), order.side};
+                writer.orderReplace(locate, order.reference, replacement.reference, replacement.shares,
+                                    replacement.price);
+                order = replacement;
+                continue;
+            } else {
+                const auto shares = static_cast<std::uint32_t>(std::min<std::uint64_t>(order.shares, 100 * (1 + rng.below(4))));
+                if (roll < 99) writer.orderExecuted(locate, order.reference, shares, match++);
+                else writer.orderCancel(locate, order.reference, shares);
+                order.shares -= shares;
+                if (order.shares > 0) continue;
+            }
+            order = orders.back();
+            orders.pop_back();
+        }
+        const auto path = (std::filesystem::temp_directory_path() / "orderbook_itch_benchmark.bin").string();
+        writer.save(path);
+        return path;
+    }
+
+    std::vector<std::string> split(const std::string &list) {
+        std::vector<std::string> items;
+        std::stringstream stream{list};
+        for (std::string item; std::getline(stream, item, ',');) items.push_back(item);
+        return items;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string path;
+    std::vector<std::string> symbols;
+    std::size_t top = 32;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--symbols" && i + 1 < argc) symbols = split(argv[++i]);
+        else if (arg == "--top" && i + 1 < argc) top = std::stoul(argv[++i]);
+        else path = arg;
+    }
+    if (path.empty()) path = generateFile(4'000'000);
+
+    Timer timer;
+    const MappedFile file = MappedFile::open(path);
+
+    // First pass: decode only, counting message types and each stock's adds.
+    std::map<char, std::size_t> types;
+    std::vector<std::size_t> adds(65'536);
+    std::vector<std::string> names(65'536);
+    std::size_t messages = 0;
+    timer.start();
+    ItchReader reader{file.bytes()};
+    while (const auto message = reader.next()) {
+        ++messages;
+        ++types[static_cast<char>(message->type())];
+        if (message->type() == Itch::MessageType::AddOrder || message->type() == Itch::MessageType::AddOrderWithMpid) {
+            if (adds[message->locate()]++ == 0) names[message->locate()] = Itch::AddOrder{message->bytes()}.stock();
+        }
+    }
+    const double scanSeconds = timer.elapsed();
+
+    if (symbols.empty()) {
+        std::vector<std::uint16_t> busiest;
+        for (std::size_t locate = 0; locate < adds.size(); ++locate)
+            if (adds[locate]) busiest.push_back(static_cast<std::uint16_t>(locate));
+        std::ranges::sort(busiest, [&](auto a, auto b) { return adds[a] > adds[b]; });
+        busiest.resize(std::min(busiest.size(), top));
+        for (const auto locate: busiest) symbols.push_back(names[locate]);
+    }
+
+    ItchBookBuilder builder{{.symbols = symbols}};
+    timer.start();
+    builder.replay(file.bytes());
+    const double replaySeconds = timer.elapsed();
+    const ItchStats &stats = builder.stats();
+    const std::uint64_t applied = stats.adds + stats.executions + stats.cancels + stats.deletes + stats.replaces;
+
+    std::cout << "\n" << path << ": " << file.size() / 1e6 << "MB, " << messages << " messages\n";
+    for (const auto &[type, count]: types) std::cout << "  " << type << ": " << count << "\n";
+    std::cout << std::fixed << std::setprecision(2)
+            << "Scan: " << scanSeconds * 1e3 << "ms, " << messages / scanSeconds / 1e6 << "M messages/s\n"
+            << "Replay into " << builder.locates().size() << " books: " << replaySeconds * 1e3 << "ms, "
+            << stats.messages / replaySeconds / 1e6 << "M messages/s, " << applied / replaySeconds / 1e6
+            << "M book messages/s (" << replaySeconds / static_cast<double>(applied) * 1e9 << "ns each)\n"
+            << "Applied: " << stats.adds << " adds, " << stats.executions << " executions, " << stats.cancels
+            << " cancels, " << stats.deletes << " deletes, " << stats.replaces << " replaces\n"
+            << "Skipped " << stats.skipped << ", unpriceable " << stats.unpriceable << ", unknown orders "
+            << stats.unknownOrders << ", crossed " << stats.crossed << "; " << builder.resting()
+            << " orders resting at the end\n\n";
+}
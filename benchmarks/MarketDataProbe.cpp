@@ -0,0 +1,91 @@
+#include "orderbook/Orderbook.h"
+#include "orderbook/MarketDataReader.h"
+#include "synthetic_order_generator/OrderExecutor.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Measures publish-to-observe latency of the shared memory quotes. A reader process forked off on
+// the same host spins on the book's slot and, for every quote it sees, records how long ago the
+// book stamped it. The book replays data/orders.txt at the given rate (events per second, 0 for
+// flat out); slot 2 tells the reader the replay is over. First, the cost of publishing is measured
+// as replay time with and without a segment attached, using slot 0.
+namespace {
+    constexpr const char *segmentName = "/orderbook_market_data_probe";
+
+    int runReader() {
+        const MarketDataReader reader{segmentName};
+        std::vector<std::uint64_t> latencies;
+        latencies.reserve(1 << 20);
+        std::uint64_t last = 0;
+        Quote quote{};
+        while (reader.sequence(2) == 0) {
+            if (reader.poll(1, last, quote)) latencies.push_back(sharedClockNs() - quote.publishedNs);
+        }
+        if (latencies.empty()) return 1;
+
+        std::ranges::sort(latencies);
+        const auto at = [&](double q) {
+            return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(q * latencies.size()))];
+        };
+        std::cout << "Reader: observed " << latencies.size() << " of " << last
+                << " quotes; publish-to-observe p50 " << at(0.5) << "ns, p90 " << at(0.9) << "ns, p99 "
+                << at(0.99) << "ns, p99.9 " << at(0.999) << "ns, max " << latencies.back() << "ns\n";
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    const auto events = OrderExecutor::getOrdersFromCsv(argc > 1 ? argv[1] : "../data/orders.txt");
+    const double rate = argc > 2 ? std::stod(argv[2]) : 50'000;
+    if (events.empty()) {
+        std::cerr << "no events\n";
+        return 1;
+    }
+
+    const auto segment = MarketDataSegment::create(segmentName, 3);
+    const auto replay = [&](bool publish) {
+        Orderbook book{false};
+        if (publish) book.publishMarketData(segment, 0);
+        const Timer timer;
+        for (const auto &e: events) OrderExecutor::apply(book, e);
+        return timer.elapsed();
+    };
+    const double plainSeconds = replay(false);
+    const double publishSeconds = replay(true);
+    std::cout << events.size() << " events: " << plainSeconds / events.size() * 1e9 << "ns/event plain, "
+            << publishSeconds / events.size() * 1e9 << "ns/event publishing quotes\n";
+
+    Orderbook book{false};
+    book.publishMarketData(segment, 1);
+    std::cout.flush();
+    const pid_t child = fork();
+    if (child == 0) std::exit(runReader());
+
+    // Give the reader time to map the segment and start spinning.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (rate > 0) {
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                              std::chrono::duration<double>(i / rate)));
+        }
+        OrderExecutor::apply(book, events[i]);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    segment.slot(2).store(Quote{});
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    std::cout << "Book: " << events.size() / seconds << " events/s, " << segment.slot(1).sequence()
+            << " quotes published\n";
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -0,0 +1,62 @@
+#include "orderbook/Orderbook.h"
+#include "shared/Timer.h"
+
+#include <iostream>
+
+// Rests a deep ask ladder, then sweeps it with a single aggressive buy, so the time is dominated
+// by the matching loop walking each level's FIFO. The second run gives every resting order an
+// owner, so each fill also unlinks it from the owner index.
+namespace {
+    struct SweepResult {
+        double seconds;
+        std::size_t matches;
+    };
+
+    SweepResult sweep(bool owned) {
+        constexpr int rounds = 200;
+        constexpr Price basePrice = 10'000;
+        constexpr int levels = 100;
+        constexpr int ordersPerLevel = 50;
+        constexpr Quantity quantity = 10;
+        constexpr OwnerId owners = 64;
+
+        Orderbook ob{false};
+        OrderId nextId = 0;
+        SweepResult result{};
+
+        for (int round = 0; round < rounds; ++round) {
+            for (int level = 0; level < levels; ++level) {
+                for (int i = 0; i < ordersPerLevel; ++i) {
+                    const OwnerId owner = owned ? static_cast<OwnerId>(1 + nextId % owners) : Constants::NO_OWNER;
+                    ob.addOrder({nextId++, OrderType::GoodTillCancel, Side::Sell, basePrice + level, quantity, owner});
+                }
+            }
+
+            const Order sweepOrder{
+                nextId++, OrderType::FillAndKill, Side::Buy, basePrice + levels, quantity * levels * ordersPerLevel
+            };
+            const Timer timer;
+            ob.addOrder(sweepOrder);
+            result.seconds += timer.elapsed();
+
+            result.matches += ob.getTrades().size();
+            ob.clearTrades();
+        }
+        return result;
+    }
+}
+
+int main() {
+    const SweepResult plain = sweep(false);
+    const SweepResult owned = sweep(true);
+
+    std::cout << "Order size: " << sizeof(Order) << " bytes, node size: " << sizeof(OrderNode) << " bytes ("
+            << 64.0 / sizeof(OrderNode) << " nodes per cache line)\n";
+    std::cout << "Owner index: " << OwnerIndex::BytesPerOwnedOrder
+            << " bytes per owned order in a side table (inline links would make the node "
+            << sizeof(OrderNode) + OwnerIndex::BytesPerOwnedOrder << " bytes)\n";
+    for (const auto &[name, r]: {std::pair{"unowned", plain}, std::pair{"owned", owned}}) {
+        std::cout << "Matches (" << name << "): " << r.matches << ", " << r.seconds / r.matches * 1e9
+                << "ns per match, " << r.matches / r.seconds / 1e6 << "M matches/s\n";
+    }
+}
@@ -0,0 +1,79 @@
+#include "orderbook/OrderIndex.h"
+#include "synthetic_order_generator/OrderExecutor.h"
+#include "shared/Timer.h"
+
+#include <iomanip>
+#include <iostream>
+
+// Replays the id operations of an order file against both order index policies: a new order is
+// a duplicate check plus an insert, a cancel an extract, a modify a find plus extract and insert.
+// Fills are not modelled, so both indexes end up holding more ids than the book would. Each pass
+// shifts the ids past the previous pass's, keeping them monotonic as a live session would.
+// The full replay through a book then uses whichever policy the library was built with.
+namespace {
+    constexpr int passes = 20;
+
+    template<class Index>
+    double replayNs(const std::vector<CompactOrderEvent> &events, std::size_t &operations) {
+        OrderId maxId = 0;
+        for (const auto &e: events) maxId = std::max(maxId, e.id);
+
+        Index index;
+        OrderSlot sink = 0;
+        operations = 0;
+        const Timer timer;
+        for (int pass = 0; pass < passes; ++pass) {
+            const OrderId shift = pass * (maxId + 1);
+            for (const auto &e: events) {
+                const OrderId id = e.id + shift;
+                switch (e.event) {
+                    case EventType::New:
+                        if (!index.contains(id)) index.insert(id, {static_cast<OrderSlot>(id), 0});
+                        break;
+                    case EventType::Cancel:
+                        sink += index.extract(id).slot;
+                        break;
+                    case EventType::Modify:
+                        if (const OrderHandle handle = index.find(id); handle.valid()) {
+                            index.extract(id);
+                            index.insert(id, handle);
+                        }
+                        break;
+                }
+            }
+            operations += events.size();
+        }
+        const double seconds = timer.elapsed();
+        if (sink == 42) std::cerr << ' '; // keep the results live
+        return seconds / static_cast<double>(operations) * 1e9;
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string path = argc > 1 ? argv[1] : "../data/orders.txt";
+    const auto events = OrderExecutor::getOrdersFromCsv(path);
+    if (events.empty()) {
+        std::cerr << "no events in " << path << '\n';
+        return 1;
+    }
+
+    std::size_t operations = 0;
+    const double hashNs = replayNs<HashOrderIndex>(events, operations);
+    const double directNs = replayNs<DirectOrderIndex>(events, operations);
+
+    double bookSeconds = 0;
+    {
+        OrderExecutor executor{MarketState{}, 0};
+        bookSeconds = executor.run(path);
+    }
+
+#ifdef ORDERBOOK_DIRECT_ORDER_INDEX
+    const char *policy = "direct";
+#else
+    const char *policy = "hash";
+#endif
+    std::cout << std::fixed << std::setprecision(2) << '\n';
+    std::cout << "Index replay of " << events.size() << " events x " << passes << ": hash " << hashNs
+            << "ns/event, direct " << directNs << "ns/event\n";
+    std::cout << "Book replay (" << policy << " index): " << bookSeconds * 1e3 << "ms\n";
+}
@@ -0,0 +1,71 @@
+#include "synthetic_order_generator/OrderGenerator.h"
+#include "synthetic_order_generator/ReplayEngine.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// ReplayBenchmark [directory|manifest] [workers]
+// Replays every file under the path, one book per file, once on a single worker and once on all
+// of them, then on all of them again with a book hash checksum every 1000 events. Without a path
+// it generates 32 synthetic symbol-days of varied length to replay.
+namespace {
+    std::string generateDays(std::size_t days) {
+        const auto root = std::filesystem::temp_directory_path() / "orderbook_replay_benchmark";
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root);
+        for (std::size_t day = 0; day < days; ++day) {
+            MarketState state{};
+            state.seed = day;
+            std::ofstream file{root / ("day" + std::to_string(day) + ".csv")};
+            for (const auto &e: OrderGenerator{state, 2'000 + 1'000 * (day % 8)}.generate()) file << e;
+        }
+        return root.string();
+    }
+
+    void print(const char *label, const ReplayReport &report) {
+        std::cout << label << ": " << report.files.size() << " files, " << report.events() << " events on "
+                << report.workers << " worker(s) in " << report.wallSeconds * 1e3 << "ms, "
+                << report.eventsPerSecond() / 1e6 << "M events/s\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    const std::string path = argc > 1 ? argv[1] : generateDays(32);
+    const std::size_t workers = argc > 2 ? std::stoul(argv[2]) : WorkStealingPool::defaultWorkers();
+    const auto files = ReplayEngine::listFiles(path);
+
+    ReplayReport serial, parallel, checksummed;
+    {
+        ReplayEngine engine{1};
+        serial = engine.run(files);
+    }
+    {
+        ReplayEngine engine{workers};
+        parallel = engine.run(files);
+    }
+    {
+        ReplayEngine engine{workers};
+        engine.checksumEvery(1'000);
+        checksummed = engine.run(files);
+    }
+
+    std::cout << "\n";
+    print("Serial", serial);
+    print("Parallel", parallel);
+    print("Checksummed", checksummed);
+    std::cout << "Matching time: " << parallel.replaySeconds() * 1e3 << "ms plain, "
+            << checksummed.replaySeconds() * 1e3 << "ms with checksums\n";
+    std::cout << "\n" << std::left << std::setw(48) << "file" << std::right << std::setw(10) << "events"
+            << std::setw(10) << "load ms" << std::setw(11) << "replay ms" << std::setw(12) << "M events/s"
+            << std::setw(8) << "worker" << "\n";
+    for (const FileReplay &file: parallel.files) {
+        std::cout << std::left << std::setw(48) << std::filesystem::path{file.path}.filename().string() << std::right
+                << std::setw(10) << file.events << std::setw(10) << std::fixed << std::setprecision(2)
+                << file.loadSeconds * 1e3 << std::setw(11) << file.replaySeconds * 1e3 << std::setw(12)
+                << file.eventsPerSecond() / 1e6 << std::setw(8) << file.worker << "\n";
+    }
+}
@@ -0,0 +1,95 @@
+#include "orderbook/StandbyReplica.h"
+#include "synthetic_order_generator/OrderExecutor.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Replays data/orders.txt into a primary book three times: plain, replicating into a ring nobody
+// reads (the cost of publishing alone) and replicating to a standby process forked off on the same
+// host. The primary samples the standby's lag as it goes; the
+// standby reports its publish-to-apply latency, promotes itself when the primary detaches and
+// checks its book hash against the one the primary left in the pipe.
+namespace {
+    constexpr const char *ringName = "/orderbook_replication_benchmark";
+
+    int runStandby(int hashPipe) {
+        StandbyReplica standby{ringName};
+        const std::atomic<bool> stop{false};
+        standby.run(stop);
+
+        const Timer timer;
+        Orderbook &book = standby.promote();
+        const double promoteSeconds = timer.elapsed();
+
+        std::uint64_t primaryHash = 0;
+        if (read(hashPipe, &primaryHash, sizeof primaryHash) != sizeof primaryHash) return 1;
+        std::cout << "Standby: applied " << standby.applied() << " events, publish-to-apply average "
+                << standby.applyLatency().averageNs() << "ns, max " << standby.applyLatency().maxNs() / 1e3
+                << "us; promote " << promoteSeconds * 1e6 << "us; book hash "
+                << (book.bookHash() == primaryHash ? "matches" : "DIFFERS") << "\n";
+        return book.bookHash() == primaryHash ? 0 : 1;
+    }
+}
+
+int main(int argc, char **argv) {
+    const auto events = OrderExecutor::getOrdersFromCsv(argc > 1 ? argv[1] : "../data/orders.txt");
+    if (events.empty()) {
+        std::cerr << "no events\n";
+        return 1;
+    }
+
+    const auto replay = [&events](bool replicate) {
+        Orderbook book{false};
+        if (replicate) book.replicateTo(ringName);
+        const Timer timer;
+        for (const auto &e: events) OrderExecutor::apply(book, e);
+        return timer.elapsed();
+    };
+    const double plainSeconds = replay(false);
+    const double publishSeconds = replay(true);
+
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) return 1;
+    auto primary = std::make_unique<Orderbook>(false);
+    ReplicationPublisher &publisher = primary->replicateTo(ringName);
+
+    std::cout.flush();
+    const pid_t child = fork();
+    if (child == 0) {
+        close(pipeFds[1]);
+        std::exit(runStandby(pipeFds[0]));
+    }
+    close(pipeFds[0]);
+
+    std::vector<ReplicationLag> samples;
+    const Timer timer;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        OrderExecutor::apply(*primary, events[i]);
+        if (i % 1'000 == 0) samples.push_back(publisher.lag());
+    }
+    const double replicatedSeconds = timer.elapsed();
+    const std::uint64_t hash = primary->bookHash();
+    const bool overrun = publisher.overrun();
+    primary.reset();
+    if (write(pipeFds[1], &hash, sizeof hash) != sizeof hash) return 1;
+
+    int status = 0;
+    waitpid(child, &status, 0);
+
+    std::ranges::sort(samples, {}, &ReplicationLag::events);
+    const ReplicationLag median = samples[samples.size() / 2];
+    const ReplicationLag worst = samples.back();
+    std::cout << "\n" << events.size() << " events\n";
+    std::cout << "Primary: " << plainSeconds / events.size() * 1e9 << "ns/event plain, "
+            << publishSeconds / events.size() * 1e9 << "ns/event publishing, "
+            << replicatedSeconds / events.size() * 1e9 << "ns/event with the standby running"
+            << (overrun ? " (OVERRUN)" : "") << "\n";
+    std::cout << "Standby lag (sampled every 1000 events): median " << median.events << " events, worst "
+            << worst.events << " events / " << worst.nanoseconds / 1e3 << "us\n";
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -0,0 +1,100 @@
+#include "orderbook/Orderbook.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Rests 200k orders around a mid price and times "what would buying Q cost?" three ways: from a
+// getOrderInfos() copy of the depth (the only option before estimateSweep), with estimateSweep,
+// and for 16 sizes at once with estimateSweeps against 16 separate estimateSweep calls.
+namespace {
+    constexpr std::size_t orders = 200'000;
+    constexpr Price mid = 30'000;
+    constexpr int repeats = 20'000;
+
+    void restOrders(Orderbook &ob) {
+        PhiloxStream rng{3, 0, 0};
+        for (std::size_t i = 0; i < orders; ++i) {
+            const bool buy = i % 2 == 0;
+            const auto offset = static_cast<Price>(1 + std::lround(std::abs(300 * rng.normal())));
+            ob.addOrder({
+                static_cast<OrderId>(i), OrderType::GoodTillCancel, buy ? Side::Buy : Side::Sell,
+                buy ? mid - offset : mid + offset, 1 + rng.below(100)
+            });
+        }
+    }
+
+    SweepEstimate fromDepthCopy(const Orderbook &ob, Quantity quantity) {
+        SweepEstimate estimate{.requested = quantity};
+        // getAsks() refers into the copy, so the copy must outlive the loop.
+        const OrderbookLevelInfos infos = ob.getOrderInfos();
+        for (const auto &level: infos.getAsks()) {
+            if (estimate.filled == quantity) break;
+            const Quantity take = std::min(level.quantity, quantity - estimate.filled);
+            estimate.filled += take;
+            estimate.notional += take * level.price;
+            estimate.worstPrice = level.price;
+            ++estimate.levels;
+        }
+        return estimate;
+    }
+
+    template<class F>
+    double timeNs(F &&f) {
+        Quantity sink = 0;
+        const Timer timer;
+        for (int r = 0; r < repeats; ++r) sink += f();
+        const double seconds = timer.elapsed();
+        if (sink == 42) std::cerr << ' '; // keep the results live
+        return seconds / repeats * 1e9;
+    }
+
+    struct Row {
+        Quantity size;
+        std::size_t levels;
+        double copyNs;
+        double sweepNs;
+    };
+}
+
+int main() {
+    std::vector<Row> rows;
+    double singlesNs = 0, batchNs = 0;
+    {
+        Orderbook ob{false};
+        restOrders(ob);
+        (void) ob.getDepthSnapshot(); // build the depth image outside the timed loop
+
+        for (const Quantity size: {Quantity{1'000}, Quantity{100'000}, Quantity{2'000'000}}) {
+            rows.push_back({
+                size, ob.estimateSweep(Side::Buy, size).levels,
+                timeNs([&] { return fromDepthCopy(ob, size).notional; }),
+                timeNs([&] { return ob.estimateSweep(Side::Buy, size).notional; })
+            });
+        }
+
+        std::vector<Quantity> sizes;
+        for (Quantity size = 1'000; sizes.size() < 16; size *= 1.5) sizes.push_back(size);
+        std::vector<SweepEstimate> out(sizes.size());
+        singlesNs = timeNs([&] {
+            Quantity total = 0;
+            for (const Quantity size: sizes) total += ob.estimateSweep(Side::Buy, size).notional;
+            return total;
+        });
+        batchNs = timeNs([&] {
+            ob.estimateSweeps(Side::Buy, sizes, out);
+            return out.back().notional;
+        });
+    }
+
+    std::cout << std::fixed << std::setprecision(1) << '\n';
+    for (const auto &row: rows) {
+        std::cout << "Buy " << std::setw(6) << row.size << " (" << std::setw(3) << row.levels << " levels): depth copy "
+                << std::setw(8) << row.copyNs << "ns, estimateSweep " << std::setw(7) << row.sweepNs << "ns\n";
+    }
+    std::cout << "16 sizes: 16 x estimateSweep " << singlesNs << "ns, estimateSweeps " << batchNs << "ns\n";
+}
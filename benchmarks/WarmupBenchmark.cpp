@@ -0,0 +1,88 @@
+#include "orderbook/Orderbook.h"
+#include "shared/Philox.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// Latency of the first events a freshly constructed book sees. Prices spread over a wide band so
+// the run touches many level-array pages and order pages, the way the opening minutes of a
+// session do. Each configuration maps fresh memory, so none of them starts warm.
+namespace {
+    struct Result {
+        double constructUs;
+        std::vector<double> eventNs;
+    };
+
+    Result run(const MemoryOptions &memory, std::size_t events) {
+        Result result{};
+        result.eventNs.reserve(events);
+
+        const Timer construct;
+        Orderbook ob{false, memory};
+        result.constructUs = construct.elapsed() * 1e6;
+
+        PhiloxStream rng{42, 0, 0};
+        constexpr Price mid = Constants::LEVELARRAY_SIZE / 2;
+        constexpr Price halfBand = 25'000;
+
+        for (std::size_t i = 0; i < events; ++i) {
+            const bool buy = rng.below(2) == 0;
+            const auto offset = static_cast<Price>(1 + rng.below(halfBand));
+            const Order order{
+                static_cast<OrderId>(i), OrderType::GoodTillCancel, buy ? Side::Buy : Side::Sell,
+                buy ? mid - offset : mid + offset, 1 + rng.below(100)
+            };
+            const Timer timer;
+            ob.addOrder(order);
+            result.eventNs.push_back(timer.elapsed() * 1e9);
+        }
+        return result;
+    }
+
+    double mean(const std::vector<double> &v, std::size_t n) {
+        n = std::min(n, v.size());
+        return std::accumulate(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(n), 0.0) / n;
+    }
+
+    double percentile(std::vector<double> v, double p) {
+        const auto nth = v.begin() + static_cast<std::ptrdiff_t>(p * (v.size() - 1));
+        std::ranges::nth_element(v, nth);
+        return *nth;
+    }
+
+    void print(const char *name, const Result &r) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(0)
+                << std::setw(12) << r.constructUs
+                << std::setw(10) << r.eventNs.front()
+                << std::setw(12) << mean(r.eventNs, 100)
+                << std::setw(12) << mean(r.eventNs, 10'000)
+                << std::setw(10) << percentile(r.eventNs, 0.99)
+                << std::setw(12) << *std::ranges::max_element(r.eventNs) << '\n';
+    }
+}
+
+int main() {
+    constexpr std::size_t events = 200'000;
+
+    const MappedRegion probe{1, {.hugePages = true}};
+    std::cout << "hugetlb pages available: " << (probe.onHugePages() ? "yes" : "no (transparent huge pages)")
+            << '\n';
+
+    // Run everything first: each book prints its instrumentation counters when destroyed.
+    const Result lazy = run({}, events);
+    const Result prefault = run({.prefault = true, .reservedOrders = events}, events);
+    const Result huge = run({.hugePages = true, .prefault = true, .reservedOrders = events}, events);
+    const Result locked = run({.hugePages = true, .prefault = true, .lock = true, .reservedOrders = events}, events);
+
+    std::cout << '\n' << std::left << std::setw(28) << "config" << std::right
+            << std::setw(12) << "build us" << std::setw(10) << "1st ns" << std::setw(12) << "first100"
+            << std::setw(12) << "first10k" << std::setw(10) << "p99" << std::setw(12) << "max ns" << '\n';
+    print("lazy (default)", lazy);
+    print("prefault", prefault);
+    print("huge pages + prefault", huge);
+    print("huge + prefault + mlock", locked);
+}
@@ -0,0 +1,381 @@
+#include "Gateway.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // epoll tags for the listeners; connections are tagged with their owner id.
+    constexpr std::uint64_t TcpListenerTag = std::uint64_t{1} << 32;
+    constexpr std::uint64_t UnixListenerTag = TcpListenerTag + 1;
+
+    [[noreturn]] void throwErrno(const std::string &what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    bool isTerminal(ExecutionReport::Type type) {
+        using enum ExecutionReport::Type;
+        return type == Filled || type == Cancelled || type == Expired || type == Killed || type == Rejected;
+    }
+
+    void watch(int epoll, int fd, std::uint32_t events, std::uint64_t tag) {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = tag;
+        if (epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) != 0) throwErrno("epoll_ctl");
+    }
+}
+
+struct Gateway::Connection {
+    int fd;
+    OwnerId owner;
+    std::unique_ptr<std::byte[]> input;
+    std::size_t inputBytes{0};
+    std::unique_ptr<std::byte[]> output;
+    std::size_t outputBegin{0};
+    std::size_t outputEnd{0};
+    // An edge was seen and the socket has not been read to EAGAIN since.
+    bool readable{true};
+    bool active{false};
+    // EOF, a socket error or an overflowing output buffer; closed at the end of the round.
+    bool closing{false};
+    // Live orders by client order id.
+    std::unordered_map<OrderId, OrderHandle> orders{};
+};
+
+Gateway::Gateway(Orderbook &book, const GatewayOptions &options)
+    : book_{book}, reports_{book.subscribeExecutions()}, options_{options} {
+    try {
+        epoll_ = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_ < 0) throwErrno("epoll_create1");
+
+        if (options_.tcpPort >= 0) {
+            tcpListener_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (tcpListener_ < 0) throwErrno("socket");
+            const int on = 1;
+            setsockopt(tcpListener_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<std::uint16_t>(options_.tcpPort));
+            if (inet_pton(AF_INET, options_.tcpAddress.c_str(), &address.sin_addr) != 1) {
+                throw std::system_error(EINVAL, std::generic_category(), "tcp address " + options_.tcpAddress);
+            }
+            if (bind(tcpListener_, reinterpret_cast<const sockaddr *>(&address), sizeof address) != 0) {
+                throwErrno("bind " + options_.tcpAddress + ":" + std::to_string(options_.tcpPort));
+            }
+            if (listen(tcpListener_, SOMAXCONN) != 0) throwErrno("listen");
+            socklen_t length = sizeof address;
+            getsockname(tcpListener_, reinterpret_cast<sockaddr *>(&address), &length);
+            tcpPort_ = ntohs(address.sin_port);
+            watch(epoll_, tcpListener_, EPOLLIN | EPOLLET, TcpListenerTag);
+        }
+
+        if (!options_.unixPath.empty()) {
+            sockaddr_un address{};
+            if (options_.unixPath.size() >= sizeof address.sun_path) {
+                throw std::system_error(ENAMETOOLONG, std::generic_category(), options_.unixPath);
+            }
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, options_.unixPath.c_str(), options_.unixPath.size() + 1);
+            unixListener_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (unixListener_ < 0) throwErrno("socket");
+            unlink(options_.unixPath.c_str());
+            if (bind(unixListener_, reinterpret_cast<const sockaddr *>(&address), sizeof address) != 0) {
+                throwErrno("bind " + options_.unixPath);
+            }
+            if (listen(unixListener_, SOMAXCONN) != 0) throwErrno("listen");
+            watch(epoll_, unixListener_, EPOLLIN | EPOLLET, UnixListenerTag);
+        }
+    } catch (...) {
+        closeAll();
+        throw;
+    }
+
+    // Owner ids 1..maxConnections, handed out lowest first.
+    const std::size_t maxConnections = std::min<std::size_t>(options_.maxConnections, 0xfffe);
+    connections_.resize(maxConnections + 1);
+    for (std::size_t owner = maxConnections; owner > 0; --owner) freeOwners_.push_back(static_cast<OwnerId>(owner));
+}
+
+Gateway::~Gateway() {
+    closeAll();
+}
+
+void Gateway::closeAll() noexcept {
+    for (auto &connection: connections_) {
+        if (connection) close(*connection);
+    }
+    if (tcpListener_ >= 0) ::close(tcpListener_);
+    if (unixListener_ >= 0) {
+        ::close(unixListener_);
+        unlink(options_.unixPath.c_str());
+    }
+    if (epoll_ >= 0) ::close(epoll_);
+    tcpListener_ = unixListener_ = epoll_ = -1;
+}
+
+void Gateway::run(const std::atomic<bool> &stop) {
+    while (!stop.load(std::memory_order_relaxed)) poll(50);
+}
+
+std::size_t Gateway::poll(int timeoutMs) {
+    epoll_event events[64];
+    const int ready = epoll_wait(epoll_, events, std::size(events), readReady_ ? 0 : timeoutMs);
+    if (ready < 0) {
+        if (errno == EINTR) return 0;
+        throwErrno("epoll_wait");
+    }
+
+    for (int i = 0; i < ready; ++i) {
+        const std::uint64_t tag = events[i].data.u64;
+        if (tag == TcpListenerTag) accept(tcpListener_);
+        else if (tag == UnixListenerTag) accept(unixListener_);
+        else if (Connection *connection = connections_[tag].get()) {
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) connection->readable = true;
+            markActive(*connection);
+        }
+    }
+
+    // Connections can join active_ while requests are applied (a passive fill), so index, not iterate.
+    for (std::size_t i = 0; i < active_.size(); ++i) readFrom(*connections_[active_[i]]);
+    std::size_t applied = 0;
+    for (std::size_t i = 0; i < active_.size(); ++i) applied += apply(*connections_[active_[i]]);
+    // Reports no request of this round caused, such as GFD expiries from the book's pruner.
+    routeReports(Constants::NO_OWNER, 0);
+    for (std::size_t i = 0; i < active_.size(); ++i) flush(*connections_[active_[i]]);
+    if (applied > 0) batches_.fetch_add(1, std::memory_order_relaxed);
+
+    readReady_ = false;
+    std::erase_if(active_, [this](OwnerId owner) {
+        Connection &connection = *connections_[owner];
+        if (connection.closing) {
+            closing_.push_back(owner);
+            return true;
+        }
+        const bool pendingOutput = connection.outputEnd != connection.outputBegin;
+        connection.active = connection.readable || pendingOutput;
+        readReady_ |= connection.readable && connection.outputEnd - connection.outputBegin <= options_.outputBufferBytes / 2;
+        return !connection.active;
+    });
+    // Closing routes reports, which can make other connections active, so not inside erase_if.
+    for (const OwnerId owner: closing_) close(*connections_[owner]);
+    if (!closing_.empty()) readReady_ = true;
+    closing_.clear();
+    return applied;
+}
+
+GatewayStats Gateway::stats() const {
+    return {
+        accepted_.load(std::memory_order_relaxed), disconnected_.load(std::memory_order_relaxed),
+        slowConsumers_.load(std::memory_order_relaxed), requests_.load(std::memory_order_relaxed),
+        reportsSent_.load(std::memory_order_relaxed), batches_.load(std::memory_order_relaxed)
+    };
+}
+
+void Gateway::accept(int listener) {
+    for (;;) {
+        const int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;
+        }
+        if (freeOwners_.empty()) {
+            ::close(fd);
+            continue;
+        }
+        if (listener == tcpListener_) {
+            const int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        }
+
+        const OwnerId owner = freeOwners_.back();
+        freeOwners_.pop_back();
+        auto connection = std::make_unique<Connection>(Connection{
+            .fd = fd, .owner = owner, .input = std::make_unique<std::byte[]>(options_.inputBufferBytes),
+            .output = std::make_unique<std::byte[]>(options_.outputBufferBytes)
+        });
+        watch(epoll_, fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, owner);
+        connections_[owner] = std::move(connection);
+        markActive(*connections_[owner]);
+        accepted_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Gateway::readFrom(Connection &connection) {
+    if (!connection.readable || connection.closing) return;
+    // Back-pressure: leave the bytes in the socket until the client reads its reports.
+    if (connection.outputEnd - connection.outputBegin > options_.outputBufferBytes / 2) return;
+
+    while (connection.inputBytes < options_.inputBufferBytes) {
+        const ssize_t got = ::read(connection.fd, connection.input.get() + connection.inputBytes,
+                                   options_.inputBufferBytes - connection.inputBytes);
+        if (got > 0) {
+            connection.inputBytes += static_cast<std::size_t>(got);
+        } else if (got == 0) {
+            connection.readable = false;
+            connection.closing = true;
+            return;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            connection.readable = false;
+            return;
+        } else if (errno != EINTR) {
+            connection.readable = false;
+            connection.closing = true;
+            return;
+        }
+    }
+}
+
+std::size_t Gateway::apply(Connection &connection) {
+    const std::size_t count = connection.inputBytes / sizeof(Protocol::Request);
+    std::size_t applied = 0;
+    for (; applied < count && !connection.closing; ++applied) {
+        Protocol::Request request;
+        std::memcpy(&request, connection.input.get() + applied * sizeof request, sizeof request);
+        apply(connection, request);
+    }
+
+    // A partial request stays at the front of the buffer until the rest arrives.
+    const std::size_t consumed = count * sizeof(Protocol::Request);
+    std::memmove(connection.input.get(), connection.input.get() + consumed, connection.inputBytes - consumed);
+    connection.inputBytes -= consumed;
+    requests_.fetch_add(applied, std::memory_order_relaxed);
+    return applied;
+}
+
+void Gateway::apply(Connection &connection, const Protocol::Request &request) {
+    using enum Protocol::RequestType;
+    switch (request.type) {
+        case NewOrder: {
+            if ((request.side != Side::Buy && request.side != Side::Sell) || request.orderType >= OrderType::Size) {
+                return reject(connection, request, Protocol::InvalidRequest);
+            }
+            if (!connection.orders.try_emplace(request.clientOrderId).second) {
+                return reject(connection, request, static_cast<std::uint8_t>(ExecutionReport::Reason::DuplicateId));
+            }
+            const OrderId id = nextOrderId_++;
+            routes_.emplace(id, Route{connection.owner, request.clientOrderId});
+            const Order order = request.orderType == OrderType::Market
+                                    ? Order{id, request.side, request.quantity, connection.owner}
+                                    : Order{
+                                        id, request.orderType, request.side, request.price, request.quantity,
+                                        connection.owner
+                                    };
+            const OrderHandle handle = book_.addOrder(order);
+            routeReports(connection.owner, request.clientTimestamp);
+            if (handle.valid()) connection.orders[request.clientOrderId] = handle;
+            else forget(connection, request.clientOrderId, id);
+            return;
+        }
+        case CancelOrder: {
+            const auto it = connection.orders.find(request.clientOrderId);
+            if (it == connection.orders.end()) return reject(connection, request, Protocol::UnknownOrder);
+            book_.cancelOrder(it->second);
+            routeReports(connection.owner, request.clientTimestamp);
+            return;
+        }
+        case ModifyOrder: {
+            const auto it = connection.orders.find(request.clientOrderId);
+            if (it == connection.orders.end()) return reject(connection, request, Protocol::UnknownOrder);
+            const OrderHandle replacement = book_.modifyOrder(it->second, request.price, request.quantity);
+            routeReports(connection.owner, request.clientTimestamp);
+            // The replacement keeps the order id; if it filled or was rejected, its reports dropped the entry.
+            if (const auto again = connection.orders.find(request.clientOrderId); again != connection.orders.end()) {
+                if (replacement.valid()) again->second = replacement;
+                else connection.orders.erase(again);
+            }
+            return;
+        }
+    }
+    reject(connection, request, Protocol::InvalidRequest);
+}
+
+void Gateway::routeReports(OwnerId requester, std::uint64_t clientTimestamp) {
+    reports_.poll([&](const ExecutionReport &report) {
+        const auto it = routes_.find(report.orderId);
+        if (it == routes_.end()) return;
+        const Route route = it->second;
+        Connection *connection = connections_[route.owner].get();
+        if (isTerminal(report.type)) {
+            routes_.erase(it);
+            if (connection) connection->orders.erase(route.clientOrderId);
+        }
+        if (!connection || connection->closing) return;
+
+        send(*connection, {
+                 report.type, static_cast<std::uint8_t>(report.reason), report.side, 0, report.price,
+                 route.clientOrderId, report.lastQuantity, report.leavesQuantity,
+                 route.owner == requester ? clientTimestamp : 0
+             });
+    });
+}
+
+void Gateway::forget(Connection &connection, OrderId clientOrderId, OrderId orderId) {
+    connection.orders.erase(clientOrderId);
+    routes_.erase(orderId);
+}
+
+void Gateway::reject(Connection &connection, const Protocol::Request &request, std::uint8_t reason) {
+    send(connection, {
+             ExecutionReport::Type::Rejected, reason, request.side, 0, request.price, request.clientOrderId, 0, 0,
+             request.clientTimestamp
+         });
+}
+
+void Gateway::markActive(Connection &connection) {
+    if (connection.active) return;
+    connection.active = true;
+    active_.push_back(connection.owner);
+}
+
+void Gateway::send(Connection &connection, const Protocol::Report &report) {
+    if (options_.outputBufferBytes - connection.outputEnd < sizeof report) {
+        std::memmove(connection.output.get(), connection.output.get() + connection.outputBegin,
+                     connection.outputEnd - connection.outputBegin);
+        connection.outputEnd -= connection.outputBegin;
+        connection.outputBegin = 0;
+        if (options_.outputBufferBytes - connection.outputEnd < sizeof report) {
+            // The matcher never waits for a client; one that stops reading is dropped.
+            connection.closing = true;
+            slowConsumers_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    std::memcpy(connection.output.get() + connection.outputEnd, &report, sizeof report);
+    connection.outputEnd += sizeof report;
+    reportsSent_.fetch_add(1, std::memory_order_relaxed);
+    markActive(connection);
+}
+
+void Gateway::flush(Connection &connection) {
+    while (connection.outputBegin < connection.outputEnd && !connection.closing) {
+        const ssize_t sent = ::send(connection.fd, connection.output.get() + connection.outputBegin,
+                                    connection.outputEnd - connection.outputBegin, MSG_NOSIGNAL);
+        if (sent > 0) connection.outputBegin += static_cast<std::size_t>(sent);
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) return; // EPOLLOUT will bring it back
+        else if (errno != EINTR) connection.closing = true;
+    }
+    if (connection.outputBegin == connection.outputEnd) connection.outputBegin = connection.outputEnd = 0;
+}
+
+void Gateway::close(Connection &connection) {
+    const OwnerId owner = connection.owner;
+    connection.closing = true;
+    book_.cancelAllForOwner(owner);
+    routeReports(owner, 0);
+
+    ::close(connection.fd);
+    connections_[owner].reset();
+    freeOwners_.push_back(owner);
+    disconnected_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,131 @@
+#ifndef ORDERBOOK_GATEWAY_H
+#define ORDERBOOK_GATEWAY_H
+
+#include "Protocol.h"
+#include "orderbook/Orderbook.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct GatewayOptions {
+    // TCP listener on tcpAddress; port 0 picks a free one, -1 disables TCP.
+    std::string tcpAddress{"127.0.0.1"};
+    int tcpPort{0};
+    // Unix-domain listener; empty disables it. A stale socket file at the path is replaced.
+    std::string unixPath;
+    std::size_t maxConnections{256};
+    // Per connection, allocated on accept. Reading from a connection pauses while its output buffer
+    // is more than half full, and a client that lets it fill up is disconnected.
+    std::size_t inputBufferBytes{64 * 1024};
+    std::size_t outputBufferBytes{1024 * 1024};
+};
+
+struct GatewayStats {
+    std::uint64_t accepted;
+    std::uint64_t disconnected;
+    std::uint64_t slowConsumers;
+    std::uint64_t requests;
+    std::uint64_t reports;
+    // Rounds that applied at least one request; requests / batches is the mean batch size.
+    std::uint64_t batches;
+};
+
+// Single-threaded order-entry gateway in front of one book. Sockets are non-blocking and registered
+// edge-triggered with epoll. Each round reads every readable connection into its buffer, applies
+// all complete requests to the book back to back, routes the book's execution reports to the
+// connections owning the orders, and then writes each connection's output once.
+//
+// Each connection is an owner in the book, so its resting orders are cancelled when it goes away.
+// The gateway subscribes to the book's execution reports and assigns the book's order ids itself,
+// so the book must not take orders from anywhere else.
+class Gateway {
+public:
+    // Opens the listeners. Throws std::system_error.
+    Gateway(Orderbook &book, const GatewayOptions &options);
+
+    ~Gateway();
+
+    Gateway(const Gateway &) = delete;
+
+    Gateway &operator=(const Gateway &) = delete;
+
+    // Runs rounds until stop is set; an idle gateway sleeps in epoll_wait for up to 50ms at a time.
+    void run(const std::atomic<bool> &stop);
+
+    // Waits up to timeoutMs for activity, then runs one round. Returns the requests applied.
+    std::size_t poll(int timeoutMs);
+
+    // The bound TCP port, or 0 if TCP is disabled.
+    [[nodiscard]] std::uint16_t tcpPort() const { return tcpPort_; }
+
+    // Safe to call from any thread.
+    [[nodiscard]] GatewayStats stats() const;
+
+private:
+    struct Connection;
+
+    struct Route {
+        OwnerId owner;
+        OrderId clientOrderId;
+    };
+
+    void closeAll() noexcept;
+
+    void accept(int listener);
+
+    void readFrom(Connection &connection);
+
+    std::size_t apply(Connection &connection);
+
+    void apply(Connection &connection, const Protocol::Request &request);
+
+    void routeReports(OwnerId requester, std::uint64_t clientTimestamp);
+
+    void markActive(Connection &connection);
+
+    void forget(Connection &connection, OrderId clientOrderId, OrderId orderId);
+
+    void send(Connection &connection, const Protocol::Report &report);
+
+    void reject(Connection &connection, const Protocol::Request &request, std::uint8_t reason);
+
+    void flush(Connection &connection);
+
+    void close(Connection &connection);
+
+    Orderbook &book_;
+    ExecutionFeed &reports_;
+    GatewayOptions options_;
+    int epoll_{-1};
+    int tcpListener_{-1};
+    int unixListener_{-1};
+    std::uint16_t tcpPort_{0};
+
+    // Indexed by owner id; slot 0 is Constants::NO_OWNER and never used.
+    std::vector<std::unique_ptr<Connection> > connections_;
+    std::vector<OwnerId> freeOwners_;
+    // Connections with input left to read or output left to write. readReady_ is set when one of
+    // them can be read right away, or a close left output to flush, so the next round does not wait
+    // in epoll_wait.
+    std::vector<OwnerId> active_;
+    bool readReady_{false};
+    // Connections to close at the end of the current round.
+    std::vector<OwnerId> closing_;
+
+    std::unordered_map<OrderId, Route> routes_;
+    OrderId nextOrderId_{1};
+
+    std::atomic<std::uint64_t> accepted_{0};
+    std::atomic<std::uint64_t> disconnected_{0};
+    std::atomic<std::uint64_t> slowConsumers_{0};
+    std::atomic<std::uint64_t> requests_{0};
+    std::atomic<std::uint64_t> reportsSent_{0};
+    std::atomic<std::uint64_t> batches_{0};
+};
+
+#endif //ORDERBOOK_GATEWAY_H
@@ -0,0 +1,147 @@
+#include "GatewayClient.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    [[noreturn]] void throwErrno(const std::string &what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Connects blocking, then switches the socket to non-blocking.
+    int connectTo(int family, const sockaddr *address, socklen_t length, const std::string &what) {
+        const int fd = socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) throwErrno("socket");
+        if (connect(fd, address, length) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "connect " + what);
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return fd;
+    }
+
+    timespec toTimespec(std::chrono::nanoseconds timeout) {
+        const auto ns = std::max<std::int64_t>(timeout.count(), 0);
+        return {static_cast<time_t>(ns / 1'000'000'000), static_cast<long>(ns % 1'000'000'000)};
+    }
+}
+
+GatewayClient::GatewayClient(int fd) : fd_{fd}, buffer_(64 * 1024) {
+}
+
+GatewayClient GatewayClient::connectTcp(const std::string &address, std::uint16_t port) {
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &target.sin_addr) != 1) {
+        throw std::system_error(EINVAL, std::generic_category(), "tcp address " + address);
+    }
+    const int fd = connectTo(AF_INET, reinterpret_cast<const sockaddr *>(&target), sizeof target,
+                             address + ":" + std::to_string(port));
+    const int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    return GatewayClient{fd};
+}
+
+GatewayClient GatewayClient::connectUnix(const std::string &path) {
+    sockaddr_un target{};
+    if (path.size() >= sizeof target.sun_path) throw std::system_error(ENAMETOOLONG, std::generic_category(), path);
+    target.sun_family = AF_UNIX;
+    std::memcpy(target.sun_path, path.c_str(), path.size() + 1);
+    return GatewayClient{connectTo(AF_UNIX, reinterpret_cast<const sockaddr *>(&target), sizeof target, path)};
+}
+
+GatewayClient::GatewayClient(GatewayClient &&other) noexcept
+    : fd_{std::exchange(other.fd_, -1)}, buffer_{std::move(other.buffer_)}, begin_{other.begin_}, end_{other.end_},
+      closed_{other.closed_} {
+}
+
+GatewayClient &GatewayClient::operator=(GatewayClient &&other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+        buffer_ = std::move(other.buffer_);
+        begin_ = other.begin_;
+        end_ = other.end_;
+        closed_ = other.closed_;
+    }
+    return *this;
+}
+
+GatewayClient::~GatewayClient() {
+    close();
+}
+
+void GatewayClient::close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+}
+
+void GatewayClient::send(const Protocol::Request &request) {
+    const auto *bytes = reinterpret_cast<const std::byte *>(&request);
+    std::size_t sent = 0;
+    while (sent < sizeof request) {
+        const ssize_t n = ::send(fd_, bytes + sent, sizeof request - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            pollfd writable{fd_, POLLOUT, 0};
+            ::poll(&writable, 1, -1);
+        } else if (errno != EINTR) {
+            throwErrno("send");
+        }
+    }
+}
+
+bool GatewayClient::receive(Protocol::Report &report, std::chrono::nanoseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        readAvailable();
+        if (end_ - begin_ >= sizeof report) {
+            std::memcpy(&report, buffer_.data() + begin_, sizeof report);
+            begin_ += sizeof report;
+            return true;
+        }
+        if (closed_ || !wait(deadline - std::chrono::steady_clock::now())) return false;
+    }
+}
+
+bool GatewayClient::wait(std::chrono::nanoseconds timeout) const {
+    pollfd readable{fd_, POLLIN, 0};
+    const timespec limit = toTimespec(timeout);
+    return ppoll(&readable, 1, &limit, nullptr) > 0;
+}
+
+void GatewayClient::readAvailable() {
+    if (begin_ == end_) begin_ = end_ = 0;
+    if (buffer_.size() - end_ < sizeof(Protocol::Report)) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    while (fd_ >= 0 && end_ < buffer_.size()) {
+        const ssize_t n = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (n > 0) {
+            end_ += static_cast<std::size_t>(n);
+        } else if (n == 0) {
+            closed_ = true;
+            return;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return;
+        } else if (errno != EINTR) {
+            throwErrno("read");
+        }
+    }
+}
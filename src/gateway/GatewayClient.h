@@ -0,0 +1,67 @@
+#ifndef ORDERBOOK_GATEWAYCLIENT_H
+#define ORDERBOOK_GATEWAYCLIENT_H
+
+#include "Protocol.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Client side of the Gateway protocol over a non-blocking socket, for tests and load generation.
+// Reports arrive in a buffer that drain() and receive() consume.
+class GatewayClient {
+public:
+    // Throw std::system_error if the gateway cannot be reached.
+    static GatewayClient connectTcp(const std::string &address, std::uint16_t port);
+
+    static GatewayClient connectUnix(const std::string &path);
+
+    GatewayClient(GatewayClient &&other) noexcept;
+
+    GatewayClient &operator=(GatewayClient &&other) noexcept;
+
+    ~GatewayClient();
+
+    // Writes the whole request, waiting for the socket if it is full. Throws std::system_error.
+    void send(const Protocol::Request &request);
+
+    // Calls f for every report that has arrived, without waiting. Returns how many there were.
+    template<class F>
+    std::size_t drain(F &&f) {
+        readAvailable();
+        std::size_t count = 0;
+        for (; end_ - begin_ >= sizeof(Protocol::Report); begin_ += sizeof(Protocol::Report), ++count) {
+            Protocol::Report report;
+            std::memcpy(&report, buffer_.data() + begin_, sizeof report);
+            f(report);
+        }
+        return count;
+    }
+
+    // Waits up to timeout for the next report.
+    bool receive(Protocol::Report &report, std::chrono::nanoseconds timeout);
+
+    // Waits up to timeout for the socket to become readable.
+    bool wait(std::chrono::nanoseconds timeout) const;
+
+    // The gateway closed the connection.
+    [[nodiscard]] bool closed() const { return closed_; }
+
+    void close();
+
+private:
+    explicit GatewayClient(int fd);
+
+    void readAvailable();
+
+    int fd_{-1};
+    std::vector<std::byte> buffer_;
+    std::size_t begin_{0};
+    std::size_t end_{0};
+    bool closed_{false};
+};
+
+#endif //ORDERBOOK_GATEWAYCLIENT_H
@@ -0,0 +1,62 @@
+#ifndef ORDERBOOK_PROTOCOL_H
+#define ORDERBOOK_PROTOCOL_H
+
+#include "orderbook/ExecutionReport.h"
+#include "orderbook/OrderType.h"
+#include "orderbook/Side.h"
+#include "orderbook/Usings.h"
+
+#include <cstdint>
+#include <type_traits>
+
+// Order-entry wire format of the Gateway. Every message has a fixed length, so a stream is framed
+// by size alone, and is sent as the raw struct in host byte order: the gateway only serves
+// clients on the same host. Order ids are the client's own and only need to be unique among that
+// connection's live orders.
+namespace Protocol {
+    enum class RequestType : std::uint8_t {
+        NewOrder = 1,
+        CancelOrder = 2,
+        // Replaces price and quantity; the order loses its time priority.
+        ModifyOrder = 3
+    };
+
+    struct Request {
+        RequestType type;
+        Side side;
+        OrderType orderType;
+        std::uint8_t reserved;
+        Price price;
+        OrderId clientOrderId;
+        Quantity quantity;
+        // Echoed in the reports this request produces for its sender, so a client can match
+        // them to the request and time the round trip.
+        std::uint64_t clientTimestamp;
+    };
+
+    // Reasons for a Rejected report beyond ExecutionReport::Reason, for requests the book never saw.
+    enum RejectReason : std::uint8_t {
+        UnknownOrder = 0x40,
+        InvalidRequest = 0x41
+    };
+
+    // One ExecutionReport of one of the connection's orders. clientTimestamp is 0 on reports caused
+    // by another connection's request, such as a passive fill.
+    struct Report {
+        ExecutionReport::Type type;
+        // ExecutionReport::Reason, or a RejectReason.
+        std::uint8_t reason;
+        Side side;
+        std::uint8_t reserved;
+        Price price;
+        OrderId clientOrderId;
+        Quantity lastQuantity;
+        Quantity leavesQuantity;
+        std::uint64_t clientTimestamp;
+    };
+
+    static_assert(sizeof(Request) == 32 && std::is_trivially_copyable_v<Request>);
+    static_assert(sizeof(Report) == 40 && std::is_trivially_copyable_v<Report>);
+}
+
+#endif //ORDERBOOK_PROTOCOL_H
@@ -0,0 +1,42 @@
+#include "gateway/Gateway.h"
+
+#include <csignal>
+#include <iostream>
+#include <string>
+
+// OrderGateway [--address 127.0.0.1] [--port 9000] [--unix /tmp/orderbook_gateway.sock]
+// Serves one book until SIGINT or SIGTERM. --port -1 or --unix "" disables that listener.
+namespace {
+    std::atomic<bool> stopRequested{false};
+
+    void requestStop(int) { stopRequested.store(true, std::memory_order_relaxed); }
+}
+
+int main(int argc, char **argv) {
+    GatewayOptions options;
+    options.tcpPort = 9000;
+    options.unixPath = "/tmp/orderbook_gateway.sock";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag == "--address") options.tcpAddress = argv[i + 1];
+        else if (flag == "--port") options.tcpPort = std::stoi(argv[i + 1]);
+        else if (flag == "--unix") options.unixPath = argv[i + 1];
+        else {
+            std::cerr << "unknown option " << flag << "\n";
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    Orderbook book;
+    Gateway gateway{book, options};
+    if (gateway.tcpPort() != 0) std::cout << "Listening on " << options.tcpAddress << ":" << gateway.tcpPort() << "\n";
+    if (!options.unixPath.empty()) std::cout << "Listening on " << options.unixPath << "\n";
+    gateway.run(stopRequested);
+
+    const GatewayStats stats = gateway.stats();
+    std::cout << stats.accepted << " connections, " << stats.requests << " requests in " << stats.batches
+            << " batches, " << stats.reports << " reports, " << stats.slowConsumers << " slow consumers dropped\n";
+}
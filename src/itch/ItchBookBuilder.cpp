@@ -0,0 +1,157 @@
+#include "ItchBookBuilder.h"
+#include "ItchReader.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+ItchBookBuilder::ItchBookBuilder(ItchOptions options) : options_{std::move(options)} {
+    if (options_.priceScale == 0) throw std::invalid_argument("ITCH: priceScale must be positive");
+}
+
+void ItchBookBuilder::apply(Itch::Message message) {
+    using Itch::MessageType;
+    ++stats_.messages;
+    const MessageType type = message.type();
+    const std::size_t size = Itch::sizeOf(type);
+    if (size == 0) {
+        ++stats_.skipped;
+        return;
+    }
+    if (message.bytes().size() < size)
+        throw std::runtime_error(std::string{"ITCH: short '"} + static_cast<char>(type) + "' message");
+
+    const std::uint16_t locate = message.locate();
+    switch (type) {
+        case MessageType::AddOrder:
+        case MessageType::AddOrderWithMpid: {
+            const Itch::AddOrder add{message.bytes()};
+            if (!bookFor(locate, add.stock())) break;
+            ++stats_.adds;
+            this->add(locate, add.reference(), add.side(), add.shares(), add.price());
+            return;
+        }
+        case MessageType::OrderExecuted:
+        case MessageType::OrderExecutedWithPrice: {
+            if (!hasBook(locate)) break;
+            ++stats_.executions;
+            const Itch::OrderExecuted executed{message.bytes()};
+            reduce(executed.reference(), executed.shares());
+            return;
+        }
+        case MessageType::OrderCancel: {
+            if (!hasBook(locate)) break;
+            ++stats_.cancels;
+            const Itch::OrderCancel cancel{message.bytes()};
+            reduce(cancel.reference(), cancel.shares());
+            return;
+        }
+        case MessageType::OrderDelete:
+            if (!hasBook(locate)) break;
+            ++stats_.deletes;
+            remove(Itch::OrderDelete{message.bytes()}.reference());
+            return;
+        case MessageType::OrderReplace:
+            if (!hasBook(locate)) break;
+            ++stats_.replaces;
+            replace(Itch::OrderReplace{message.bytes()});
+            return;
+        case MessageType::StockDirectory:
+            if (locate >= stocks_.size()) stocks_.resize(locate + 1);
+            if (!stocks_[locate].decided) stocks_[locate].symbol = Itch::StockDirectory{message.bytes()}.stock();
+            break;
+        case MessageType::SystemEvent:
+            break;
+    }
+    ++stats_.skipped;
+}
+
+void ItchBookBuilder::replay(std::span<const std::byte> file) {
+    ItchReader reader{file};
+    while (const auto message = reader.next()) apply(*message);
+}
+
+Orderbook *ItchBookBuilder::book(std::uint16_t locate) const {
+    return locate < stocks_.size() ? stocks_[locate].book.get() : nullptr;
+}
+
+std::string_view ItchBookBuilder::symbol(std::uint16_t locate) const {
+    return locate < stocks_.size() ? std::string_view{stocks_[locate].symbol} : std::string_view{};
+}
+
+std::vector<std::uint16_t> ItchBookBuilder::locates() const {
+    std::vector<std::uint16_t> locates;
+    for (std::size_t locate = 0; locate < stocks_.size(); ++locate)
+        if (stocks_[locate].book) locates.push_back(static_cast<std::uint16_t>(locate));
+    return locates;
+}
+
+Orderbook *ItchBookBuilder::bookFor(std::uint16_t locate, std::string_view symbol) {
+    if (locate >= stocks_.size()) stocks_.resize(locate + 1);
+    Stock &stock = stocks_[locate];
+    if (!stock.decided) [[unlikely]] {
+        stock.decided = true;
+        if (stock.symbol.empty()) stock.symbol = symbol;
+        if (options_.symbols.empty() || std::ranges::find(options_.symbols, stock.symbol) != options_.symbols.end())
+            stock.book = std::make_unique<Orderbook>(false, options_.memory);
+    }
+    return stock.book.get();
+}
+
+std::optional<Price> ItchBookBuilder::toTicks(std::uint32_t price) const {
+    if (price % options_.priceScale != 0) return std::nullopt;
+    const std::uint32_t ticks = price / options_.priceScale;
+    if (ticks >= Constants::LEVELARRAY_SIZE) return std::nullopt;
+    return static_cast<Price>(ticks);
+}
+
+void ItchBookBuilder::add(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares,
+                          std::uint32_t price) {
+    const std::optional<Price> ticks = toTicks(price);
+    if (!ticks) {
+        ++stats_.unpriceable;
+        return;
+    }
+    const SubmitResult result = stocks_[locate].book->submit({
+        reference, OrderType::GoodTillCancel, side, *ticks, shares
+    });
+    if (result.fills) ++stats_.crossed;
+    if (result.resting()) orders_.emplace(reference, Resting{result.handle, locate, side});
+}
+
+void ItchBookBuilder::reduce(std::uint64_t reference, std::uint32_t shares) {
+    const auto it = orders_.find(reference);
+    if (it == orders_.end()) {
+        ++stats_.unknownOrders;
+        return;
+    }
+    Resting &order = it->second;
+    Orderbook &book = *stocks_[order.locate].book;
+    // In place, so the order keeps its queue position; the book reduces from its own quantity,
+    // which a crossed add may already have filled below what the feed shows.
+    const std::optional<Quantity> remaining = book.reduceOrder(order.handle, shares);
+    if (!remaining) ++stats_.unknownOrders;
+    if (!remaining || *remaining == 0) orders_.erase(it);
+}
+
+void ItchBookBuilder::remove(std::uint64_t reference) {
+    const auto it = orders_.find(reference);
+    if (it == orders_.end()) {
+        ++stats_.unknownOrders;
+        return;
+    }
+    if (!stocks_[it->second.locate].book->cancelOrder(it->second.handle)) ++stats_.unknownOrders;
+    orders_.erase(it);
+}
+
+void ItchBookBuilder::replace(const Itch::OrderReplace &message) {
+    const auto it = orders_.find(message.originalReference());
+    if (it == orders_.end()) {
+        ++stats_.unknownOrders;
+        return;
+    }
+    const Resting order = it->second;
+    orders_.erase(it);
+    if (!stocks_[order.locate].book->cancelOrder(order.handle)) ++stats_.unknownOrders;
+    add(order.locate, message.newReference(), order.side, message.shares(), message.price());
+}
@@ -0,0 +1,115 @@
+#ifndef ORDERBOOK_ITCHBOOKBUILDER_H
+#define ORDERBOOK_ITCHBOOKBUILDER_H
+
+#include "ItchMessages.h"
+#include "orderbook/Orderbook.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct ItchOptions {
+    // ITCH prices carry four implied decimals and become ticks by dividing by priceScale. The
+    // default gives cent ticks, so the level array covers $0.00 to $599.99. Must not be zero.
+    std::uint32_t priceScale{100};
+    // Stocks to build books for; empty builds one for every stock in the file.
+    std::vector<std::string> symbols;
+    MemoryOptions memory{};
+};
+
+struct ItchStats {
+    std::uint64_t messages;
+    std::uint64_t adds;
+    std::uint64_t executions;
+    std::uint64_t cancels;
+    std::uint64_t deletes;
+    std::uint64_t replaces;
+    // Other message types, and messages for stocks without a book.
+    std::uint64_t skipped;
+    // Adds and replaces whose price is not a whole tick inside the level array. The order is
+    // dropped, so later messages for it count as unknown.
+    std::uint64_t unpriceable;
+    // Executions, cancels, deletes and replaces of an order the builder does not hold, or that a
+    // crossed add has already filled.
+    std::uint64_t unknownOrders;
+    // Adds and replaces the book matched instead of resting them whole. A consistent feed never
+    // crosses, so from then on the book and the feed disagree.
+    std::uint64_t crossed;
+};
+
+// Rebuilds the order books of an ITCH 5.0 feed: one Orderbook per stock locate code, created on
+// the stock's first add. Adds rest as GoodTillCancel orders with the ITCH order reference number
+// as their id, and a replace cancels the order and adds its replacement under the new number.
+// An execution or partial cancel reduces the order's remaining quantity in the book (which a
+// crossed add may already have reduced) through a handle-based modify; a delete, or an
+// execution or cancel of everything left, cancels it. A modify loses time priority, so level
+// quantities and counts follow the feed exactly while the order within a level may not.
+//
+// Every book reserves its order index up front (a few MB), so a whole-market file is best
+// replayed with a list of symbols.
+class ItchBookBuilder {
+public:
+    explicit ItchBookBuilder(ItchOptions options = {});
+
+    // Applies one message. Throws std::runtime_error if it is shorter than its type requires.
+    void apply(Itch::Message message);
+
+    // Applies every message of a file image; see ItchReader.
+    void replay(std::span<const std::byte> file);
+
+    [[nodiscard]] const ItchStats &stats() const { return stats_; }
+
+    // The book built for locate, or nullptr.
+    [[nodiscard]] Orderbook *book(std::uint16_t locate) const;
+
+    // The stock at locate, from its StockDirectory or first add message; empty if not seen yet.
+    [[nodiscard]] std::string_view symbol(std::uint16_t locate) const;
+
+    // The locates that have a book, ascending.
+    [[nodiscard]] std::vector<std::uint16_t> locates() const;
+
+    // Orders resting across all books.
+    [[nodiscard]] std::size_t resting() const { return orders_.size(); }
+
+private:
+    struct Stock {
+        std::string symbol;
+        std::unique_ptr<Orderbook> book;
+        bool decided{false};
+    };
+
+    struct Resting {
+        OrderHandle handle;
+        std::uint16_t locate;
+        Side side;
+    };
+
+    // The book for locate, deciding on the stock's first add whether it gets one.
+    Orderbook *bookFor(std::uint16_t locate, std::string_view symbol);
+
+    [[nodiscard]] std::optional<Price> toTicks(std::uint32_t price) const;
+
+    void add(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares, std::uint32_t price);
+
+    void reduce(std::uint64_t reference, std::uint32_t shares);
+
+    void remove(std::uint64_t reference);
+
+    void replace(const Itch::OrderReplace &message);
+
+    [[nodiscard]] bool hasBook(std::uint16_t locate) const {
+        return locate < stocks_.size() && stocks_[locate].book;
+    }
+
+    ItchOptions options_;
+    std::vector<Stock> stocks_;
+    std::unordered_map<std::uint64_t, Resting> orders_;
+    ItchStats stats_{};
+};
+
+#endif //ORDERBOOK_ITCHBOOKBUILDER_H
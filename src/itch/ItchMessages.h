@@ -0,0 +1,152 @@
+#ifndef ORDERBOOK_ITCHMESSAGES_H
+#define ORDERBOOK_ITCHMESSAGES_H
+
+#include "orderbook/Side.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+// Views over NASDAQ TotalView-ITCH 5.0 messages, read in place from the file buffer. Fields are
+// big-endian at fixed offsets; each accessor loads its field on demand, so a message is never
+// copied or decoded as a whole. Only the messages that change the order book have views.
+namespace Itch {
+    template<class T>
+    T load(const std::byte *p) {
+        T value;
+        std::memcpy(&value, p, sizeof value);
+        if constexpr (std::endian::native == std::endian::little) value = std::byteswap(value);
+        return value;
+    }
+
+    // Timestamps are 6 bytes: nanoseconds since midnight.
+    inline std::uint64_t load48(const std::byte *p) {
+        return std::uint64_t{load<std::uint16_t>(p)} << 32 | load<std::uint32_t>(p + 2);
+    }
+
+    template<class T>
+    void store(std::byte *p, T value) {
+        if constexpr (std::endian::native == std::endian::little) value = std::byteswap(value);
+        std::memcpy(p, &value, sizeof value);
+    }
+
+    enum class MessageType : char {
+        SystemEvent = 'S',
+        StockDirectory = 'R',
+        AddOrder = 'A',
+        AddOrderWithMpid = 'F',
+        OrderExecuted = 'E',
+        OrderExecutedWithPrice = 'C',
+        OrderCancel = 'X',
+        OrderDelete = 'D',
+        OrderReplace = 'U'
+    };
+
+    // Message length for each type the views cover, or 0 for any other type.
+    constexpr std::size_t sizeOf(MessageType type) {
+        switch (type) {
+            case MessageType::SystemEvent: return 12;
+            case MessageType::StockDirectory: return 39;
+            case MessageType::AddOrder: return 36;
+            case MessageType::AddOrderWithMpid: return 40;
+            case MessageType::OrderExecuted: return 31;
+            case MessageType::OrderExecutedWithPrice: return 36;
+            case MessageType::OrderCancel: return 23;
+            case MessageType::OrderDelete: return 19;
+            case MessageType::OrderReplace: return 35;
+        }
+        return 0;
+    }
+
+    // Stock symbols are 8 bytes of ASCII, padded on the right with spaces.
+    inline std::string_view symbolAt(const std::byte *p) {
+        std::string_view symbol{reinterpret_cast<const char *>(p), 8};
+        return symbol.substr(0, symbol.find_last_not_of(' ') + 1);
+    }
+
+    // The header every message starts with: type, stock locate, tracking number and timestamp.
+    class Message {
+    public:
+        explicit Message(std::span<const std::byte> bytes) : bytes_{bytes} {
+        }
+
+        [[nodiscard]] MessageType type() const { return static_cast<MessageType>(bytes_[0]); }
+
+        // The day's index of the stock, from the StockDirectory message; 0 for market-wide messages.
+        [[nodiscard]] std::uint16_t locate() const { return load<std::uint16_t>(at(1)); }
+
+        [[nodiscard]] std::uint64_t timestamp() const { return load48(at(5)); }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return bytes_; }
+
+    protected:
+        [[nodiscard]] const std::byte *at(std::size_t offset) const { return bytes_.data() + offset; }
+
+    private:
+        std::span<const std::byte> bytes_;
+    };
+
+    struct StockDirectory : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::string_view stock() const { return symbolAt(at(11)); }
+    };
+
+    // Also the view of AddOrderWithMpid, which only appends a 4-byte attribution.
+    struct AddOrder : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::uint64_t reference() const { return load<std::uint64_t>(at(11)); }
+
+        [[nodiscard]] Side side() const { return *at(19) == std::byte{'B'} ? Side::Buy : Side::Sell; }
+
+        [[nodiscard]] std::uint32_t shares() const { return load<std::uint32_t>(at(20)); }
+
+        [[nodiscard]] std::string_view stock() const { return symbolAt(at(24)); }
+
+        // Four implied decimals: 1502500 is $150.25.
+        [[nodiscard]] std::uint32_t price() const { return load<std::uint32_t>(at(32)); }
+    };
+
+    // Also the view of OrderExecutedWithPrice, whose extra fields only describe the print.
+    struct OrderExecuted : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::uint64_t reference() const { return load<std::uint64_t>(at(11)); }
+
+        [[nodiscard]] std::uint32_t shares() const { return load<std::uint32_t>(at(19)); }
+
+        [[nodiscard]] std::uint64_t matchNumber() const { return load<std::uint64_t>(at(23)); }
+    };
+
+    struct OrderCancel : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::uint64_t reference() const { return load<std::uint64_t>(at(11)); }
+
+        [[nodiscard]] std::uint32_t shares() const { return load<std::uint32_t>(at(19)); }
+    };
+
+    struct OrderDelete : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::uint64_t reference() const { return load<std::uint64_t>(at(11)); }
+    };
+
+    struct OrderReplace : Message {
+        using Message::Message;
+
+        [[nodiscard]] std::uint64_t originalReference() const { return load<std::uint64_t>(at(11)); }
+
+        [[nodiscard]] std::uint64_t newReference() const { return load<std::uint64_t>(at(19)); }
+
+        [[nodiscard]] std::uint32_t shares() const { return load<std::uint32_t>(at(27)); }
+
+        [[nodiscard]] std::uint32_t price() const { return load<std::uint32_t>(at(31)); }
+    };
+}
+
+#endif //ORDERBOOK_ITCHMESSAGES_H
@@ -0,0 +1,44 @@
+#ifndef ORDERBOOK_ITCHREADER_H
+#define ORDERBOOK_ITCHREADER_H
+
+#include "ItchMessages.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// Walks the messages of an ITCH 5.0 file image, as NASDAQ distributes them: every message is
+// preceded by its length as a 2-byte big-endian integer. Messages are handed out as views into
+// the image, which must outlive them.
+class ItchReader {
+public:
+    explicit ItchReader(std::span<const std::byte> file) : file_{file} {
+    }
+
+    // The next message, or nullopt at the end of the image. Throws std::runtime_error if a length
+    // prefix is zero or runs past the end.
+    std::optional<Itch::Message> next() {
+        if (offset_ == file_.size()) return std::nullopt;
+        if (file_.size() - offset_ < 2) truncated();
+        const std::size_t length = Itch::load<std::uint16_t>(file_.data() + offset_);
+        if (length == 0 || file_.size() - offset_ - 2 < length) truncated();
+        const Itch::Message message{file_.subspan(offset_ + 2, length)};
+        offset_ += 2 + length;
+        return message;
+    }
+
+    // Bytes consumed so far.
+    [[nodiscard]] std::size_t offset() const { return offset_; }
+
+private:
+    [[noreturn]] void truncated() const {
+        throw std::runtime_error("ITCH: bad message length at offset " + std::to_string(offset_));
+    }
+
+    std::span<const std::byte> file_;
+    std::size_t offset_{0};
+};
+
+#endif //ORDERBOOK_ITCHREADER_H
@@ -0,0 +1,100 @@
+#include "ItchWriter.h"
+
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+
+namespace {
+    void putSymbol(std::byte *p, std::string_view text, std::size_t width) {
+        for (std::size_t i = 0; i < width; ++i) p[i] = std::byte(i < text.size() ? text[i] : ' ');
+    }
+
+    std::byte sideCode(Side side) { return std::byte(side == Side::Buy ? 'B' : 'S'); }
+}
+
+std::byte *ItchWriter::begin(Itch::MessageType type, std::uint16_t locate) {
+    const std::size_t length = Itch::sizeOf(type);
+    const std::size_t start = bytes_.size();
+    bytes_.resize(start + 2 + length);
+    std::byte *p = bytes_.data() + start;
+    Itch::store(p, static_cast<std::uint16_t>(length));
+    p += 2;
+    p[0] = static_cast<std::byte>(type);
+    Itch::store(p + 1, locate);
+    Itch::store(p + 5, static_cast<std::uint16_t>(timestamp_ >> 32));
+    Itch::store(p + 7, static_cast<std::uint32_t>(timestamp_));
+    return p;
+}
+
+void ItchWriter::systemEvent(char code) {
+    begin(Itch::MessageType::SystemEvent, 0)[11] = std::byte(code);
+}
+
+void ItchWriter::stockDirectory(std::uint16_t locate, std::string_view stock) {
+    std::byte *p = begin(Itch::MessageType::StockDirectory, locate);
+    putSymbol(p + 11, stock, 8);
+}
+
+void ItchWriter::addOrder(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares,
+                          std::string_view stock, std::uint32_t price) {
+    std::byte *p = begin(Itch::MessageType::AddOrder, locate);
+    Itch::store(p + 11, reference);
+    p[19] = sideCode(side);
+    Itch::store(p + 20, shares);
+    putSymbol(p + 24, stock, 8);
+    Itch::store(p + 32, price);
+}
+
+void ItchWriter::addOrderWithMpid(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares,
+                                  std::string_view stock, std::uint32_t price, std::string_view mpid) {
+    std::byte *p = begin(Itch::MessageType::AddOrderWithMpid, locate);
+    Itch::store(p + 11, reference);
+    p[19] = sideCode(side);
+    Itch::store(p + 20, shares);
+    putSymbol(p + 24, stock, 8);
+    Itch::store(p + 32, price);
+    putSymbol(p + 36, mpid, 4);
+}
+
+void ItchWriter::orderExecuted(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares,
+                               std::uint64_t match) {
+    std::byte *p = begin(Itch::MessageType::OrderExecuted, locate);
+    Itch::store(p + 11, reference);
+    Itch::store(p + 19, shares);
+    Itch::store(p + 23, match);
+}
+
+void ItchWriter::orderExecutedWithPrice(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares,
+                                        std::uint64_t match, std::uint32_t price) {
+    std::byte *p = begin(Itch::MessageType::OrderExecutedWithPrice, locate);
+    Itch::store(p + 11, reference);
+    Itch::store(p + 19, shares);
+    Itch::store(p + 23, match);
+    p[31] = std::byte{'Y'};
+    Itch::store(p + 32, price);
+}
+
+void ItchWriter::orderCancel(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares) {
+    std::byte *p = begin(Itch::MessageType::OrderCancel, locate);
+    Itch::store(p + 11, reference);
+    Itch::store(p + 19, shares);
+}
+
+void ItchWriter::orderDelete(std::uint16_t locate, std::uint64_t reference) {
+    Itch::store(begin(Itch::MessageType::OrderDelete, locate) + 11, reference);
+}
+
+void ItchWriter::orderReplace(std::uint16_t locate, std::uint64_t original, std::uint64_t replacement,
+                              std::uint32_t shares, std::uint32_t price) {
+    std::byte *p = begin(Itch::MessageType::OrderReplace, locate);
+    Itch::store(p + 11, original);
+    Itch::store(p + 19, replacement);
+    Itch::store(p + 27, shares);
+    Itch::store(p + 31, price);
+}
+
+void ItchWriter::save(const std::string &path) const {
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char *>(bytes_.data()), static_cast<std::streamsize>(bytes_.size()));
+    if (!file) throw std::system_error(errno, std::generic_category(), "write " + path);
+}
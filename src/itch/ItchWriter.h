@@ -0,0 +1,53 @@
+#ifndef ORDERBOOK_ITCHWRITER_H
+#define ORDERBOOK_ITCHWRITER_H
+
+#include "ItchMessages.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Encodes the messages ItchMessages.h reads into a length-prefixed ITCH 5.0 file image, for tests
+// and synthetic benchmark input. Each message is stamped with the current timestamp.
+class ItchWriter {
+public:
+    void setTimestamp(std::uint64_t nanosSinceMidnight) { timestamp_ = nanosSinceMidnight; }
+
+    void systemEvent(char code);
+
+    void stockDirectory(std::uint16_t locate, std::string_view stock);
+
+    void addOrder(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares,
+                  std::string_view stock, std::uint32_t price);
+
+    void addOrderWithMpid(std::uint16_t locate, std::uint64_t reference, Side side, std::uint32_t shares,
+                          std::string_view stock, std::uint32_t price, std::string_view mpid);
+
+    void orderExecuted(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares, std::uint64_t match);
+
+    void orderExecutedWithPrice(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares,
+                                std::uint64_t match, std::uint32_t price);
+
+    void orderCancel(std::uint16_t locate, std::uint64_t reference, std::uint32_t shares);
+
+    void orderDelete(std::uint16_t locate, std::uint64_t reference);
+
+    void orderReplace(std::uint16_t locate, std::uint64_t original, std::uint64_t replacement,
+                      std::uint32_t shares, std::uint32_t price);
+
+    [[nodiscard]] const std::vector<std::byte> &bytes() const { return bytes_; }
+
+    // Throws std::system_error.
+    void save(const std::string &path) const;
+
+private:
+    // Appends the length prefix and header of a message of type and returns its first byte.
+    std::byte *begin(Itch::MessageType type, std::uint16_t locate);
+
+    std::vector<std::byte> bytes_;
+    std::uint64_t timestamp_{0};
+};
+
+#endif //ORDERBOOK_ITCHWRITER_H
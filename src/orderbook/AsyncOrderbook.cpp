@@ -0,0 +1,90 @@
+#include "AsyncOrderbook.h"
+
+void AsyncTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> coroutine) noexcept {
+    AsyncOrderbook *owner = coroutine.promise().owner;
+    coroutine.destroy();
+    owner->onTaskDone();
+}
+
+AsyncOrderbook::AsyncOrderbook(Orderbook &book) : book_{book} {
+    executor_ = std::thread{[this] { run(); }};
+}
+
+AsyncOrderbook::~AsyncOrderbook() {
+    {
+        std::scoped_lock _{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    executor_.join();
+}
+
+void AsyncOrderbook::spawn(AsyncTask task) {
+    const auto coroutine = std::exchange(task.coroutine_, {});
+    coroutine.promise().owner = this;
+    {
+        std::scoped_lock _{mutex_};
+        ++liveTasks_;
+    }
+    enqueue({coroutine, nullptr, nullptr});
+}
+
+void AsyncOrderbook::waitIdle() {
+    std::unique_lock lock{mutex_};
+    idle_.wait(lock, [this] { return liveTasks_ == 0; });
+}
+
+std::size_t AsyncOrderbook::liveTasks() const {
+    std::scoped_lock _{mutex_};
+    return liveTasks_;
+}
+
+void AsyncOrderbook::enqueue(Pending pending) {
+    bool wasEmpty;
+    {
+        std::scoped_lock _{mutex_};
+        wasEmpty = queue_.empty();
+        queue_.push_back(pending);
+    }
+    if (wasEmpty) wake_.notify_one();
+}
+
+void AsyncOrderbook::onTaskDone() {
+    bool idle;
+    {
+        std::scoped_lock _{mutex_};
+        idle = --liveTasks_ == 0;
+    }
+    if (idle) idle_.notify_all();
+}
+
+// Drains the queue in batches: a strategy resumed here usually submits again at once, and its
+// next order joins the following batch rather than taking the lock for a wakeup.
+void AsyncOrderbook::run() {
+    std::vector<Pending> batch;
+    for (;;) {
+        {
+            std::unique_lock lock{mutex_};
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) break;
+            batch.swap(queue_);
+        }
+        for (const Pending &pending: batch) {
+            if (pending.order) {
+                *pending.result = book_.submit(*pending.order);
+                submitted_.fetch_add(1, std::memory_order_relaxed);
+            }
+            pending.coroutine.resume();
+        }
+        batch.clear();
+    }
+
+    // Whatever is still queued never resumes. Frames suspended elsewhere (awaiting something other
+    // than this executor) are the caller's to destroy.
+    std::vector<Pending> abandoned;
+    {
+        std::scoped_lock _{mutex_};
+        abandoned.swap(queue_);
+    }
+    for (const Pending &pending: abandoned) pending.coroutine.destroy();
+}
@@ -0,0 +1,145 @@
+#ifndef ORDERBOOK_ASYNCORDERBOOK_H
+#define ORDERBOOK_ASYNCORDERBOOK_H
+
+#include "Orderbook.h"
+#include "SubmitResult.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class AsyncOrderbook;
+
+// A fire-and-forget coroutine run by AsyncOrderbook::spawn(). It starts suspended, runs on the
+// executor thread and frees its own frame when it finishes.
+class AsyncTask {
+public:
+    struct promise_type {
+        AsyncOrderbook *owner{nullptr};
+
+        AsyncTask get_return_object() { return AsyncTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<promise_type> coroutine) noexcept;
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    AsyncTask(AsyncTask &&other) noexcept : coroutine_{std::exchange(other.coroutine_, {})} {}
+
+    AsyncTask(const AsyncTask &) = delete;
+
+    AsyncTask &operator=(const AsyncTask &) = delete;
+
+    AsyncTask &operator=(AsyncTask &&) = delete;
+
+    ~AsyncTask() {
+        if (coroutine_) coroutine_.destroy();
+    }
+
+private:
+    friend class AsyncOrderbook;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> coroutine) : coroutine_{coroutine} {}
+
+    std::coroutine_handle<promise_type> coroutine_;
+};
+
+// Coroutine front end for an Orderbook. One executor thread owns all matching: co_await submit(order)
+// queues the order and suspends the caller; the executor submits it and resumes the caller inline
+// with the SubmitResult, so everything after the co_await also runs on the executor thread.
+// Thousands of strategies written as AsyncTasks thus share one thread, and a suspended strategy
+// costs only its coroutine frame. The book stays usable directly; its lock serializes the two.
+class AsyncOrderbook {
+public:
+    explicit AsyncOrderbook(Orderbook &book);
+
+    // Stops the executor once its current batch is done. Tasks still waiting on it are destroyed
+    // without resuming.
+    ~AsyncOrderbook();
+
+    AsyncOrderbook(const AsyncOrderbook &) = delete;
+
+    AsyncOrderbook &operator=(const AsyncOrderbook &) = delete;
+
+    class SubmitAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> coroutine) {
+            book_.enqueue({coroutine, &order_, &result_});
+        }
+
+        SubmitResult await_resume() const noexcept { return result_; }
+
+    private:
+        friend class AsyncOrderbook;
+
+        SubmitAwaiter(AsyncOrderbook &book, const Order &order) : book_{book}, order_{order} {}
+
+        AsyncOrderbook &book_;
+        Order order_;
+        SubmitResult result_;
+    };
+
+    // Resolves once the executor has run Orderbook::submit() for order.
+    [[nodiscard]] SubmitAwaiter submit(const Order &order) { return {*this, order}; }
+
+    // Starts task on the executor thread.
+    void spawn(AsyncTask task);
+
+    // Blocks until every spawned task has finished.
+    void waitIdle();
+
+    [[nodiscard]] std::size_t liveTasks() const;
+
+    // Orders submitted through this executor.
+    [[nodiscard]] std::size_t submitted() const { return submitted_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] Orderbook &book() { return book_; }
+
+private:
+    friend struct AsyncTask::promise_type::FinalAwaiter;
+
+    // A coroutine to resume, and the order to submit first when order is set.
+    struct Pending {
+        std::coroutine_handle<> coroutine;
+        const Order *order;
+        SubmitResult *result;
+    };
+
+    void enqueue(Pending pending);
+
+    void run();
+
+    void onTaskDone();
+
+    Orderbook &book_;
+    std::vector<Pending> queue_;
+    std::size_t liveTasks_{0};
+    bool stopping_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::atomic<std::size_t> submitted_{0};
+    std::thread executor_;
+};
+
+#endif //ORDERBOOK_ASYNCORDERBOOK_H
@@ -0,0 +1,70 @@
+#ifndef ORDERBOOK_AUCTION_H
+#define ORDERBOOK_AUCTION_H
+
+#include "LevelKernels.h"
+#include "Usings.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+struct AuctionResult {
+    Price price;
+    Quantity volume;
+    // Unexecuted quantity at the clearing price on the heavier side.
+    Quantity surplus;
+};
+
+// Finds the uncrossing price of a crossed book: the one that maximizes executed volume, then
+// minimizes surplus, then lies nearest the reference price. Only the crossed band [best ask,
+// best bid] can execute, so the contiguous level quantities of that band are turned into
+// cumulative supply and demand with a SIMD prefix sum. Buffers are reused between auctions.
+class AuctionClearing {
+public:
+    template<class Bids, class Asks>
+    std::optional<AuctionResult> compute(const Bids &bids, const Asks &asks, std::optional<Price> reference) {
+        const auto bestBid = bids.getBestPrice();
+        const auto bestAsk = asks.getBestPrice();
+        if (!bestBid || !bestAsk || *bestBid < *bestAsk) return std::nullopt;
+
+        const Price low = *bestAsk;
+        const std::size_t n = static_cast<std::size_t>(*bestBid - low) + 1;
+        if (demand_.size() < n) {
+            demand_.resize(n);
+            supply_.resize(n);
+        }
+
+        const auto &kernels = LevelKernels::active();
+        kernels.inclusivePrefixSum(bids.quantities() + low, demand_.data(), n);
+        kernels.inclusivePrefixSum(asks.quantities() + low, supply_.data(), n);
+
+        const Quantity totalDemand = demand_[n - 1];
+        const Price anchor = reference.value_or(low);
+        std::optional<AuctionResult> best;
+        for (std::size_t i = 0; i < n; ++i) {
+            // Bids priced at or above, asks priced at or below.
+            const Quantity demand = totalDemand - (i == 0 ? 0 : demand_[i - 1]);
+            const Quantity supply = supply_[i];
+            const Quantity volume = std::min(demand, supply);
+            const Quantity surplus = demand > supply ? demand - supply : supply - demand;
+            const Price price = low + static_cast<Price>(i);
+
+            if (!best || volume > best->volume ||
+                (volume == best->volume && (surplus < best->surplus ||
+                                            (surplus == best->surplus &&
+                                             distance(price, anchor) < distance(best->price, anchor))))) {
+                best = AuctionResult{price, volume, surplus};
+            }
+        }
+        return best;
+    }
+
+private:
+    static Price distance(Price a, Price b) { return a > b ? a - b : b - a; }
+
+    std::vector<Quantity> demand_;
+    std::vector<Quantity> supply_;
+};
+
+#endif //ORDERBOOK_AUCTION_H
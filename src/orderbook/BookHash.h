@@ -0,0 +1,41 @@
+#ifndef ORDERBOOK_BOOKHASH_H
+#define ORDERBOOK_BOOKHASH_H
+
+#include "Order.h"
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+// Zobrist-style hash of the resting book: the XOR of one term per resting order over its id, side,
+// price, remaining quantity and the id of the order queued directly ahead of it at its level.
+// Chaining on the order ahead pins each order's queue position, yet a cancel only changes the
+// terms of the cancelled order and of the one behind it, so every add, fill and cancel updates
+// the hash in O(1). Two books with equal hashes hold, with overwhelming probability, the same
+// orders in the same time priority, whatever slots or history got them there.
+namespace BookHash {
+    // splitmix64's finalizer.
+    inline std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // ahead is the id of the order queued directly in front of order; nullopt at the front.
+    // The fields are folded with independent odd multipliers, which is only a few cycles deep,
+    // and the finalizer then spreads every input bit over the whole term.
+    inline std::uint64_t term(const Order &order, std::optional<OrderId> ahead) {
+        const std::uint64_t priceSide = static_cast<std::uint32_t>(order.getPrice())
+                                        | std::uint64_t{std::to_underlying(order.getSide())} << 32;
+        const std::uint64_t position = ahead ? *ahead * 0xd6e8feb86659fd93ULL : 0x2545f4914f6cdd1dULL;
+        const std::uint64_t key = order.getId() * 0x9e3779b97f4a7c15ULL + position;
+        const std::uint64_t state = priceSide * 0xc2b2ae3d27d4eb4fULL + order.getRemainingQuantity() * 0x165667b19e3779f9ULL;
+        return mix(key ^ std::rotl(state, 32));
+    }
+}
+
+#endif //ORDERBOOK_BOOKHASH_H
@@ -0,0 +1,33 @@
+#include "BookPool.h"
+
+BookPool::BookPool(const MemoryOptions &memory, std::size_t prewarm) : memory_{memory} {
+    idle_.reserve(prewarm);
+    for (std::size_t i = 0; i < prewarm; ++i) {
+        idle_.push_back(std::make_unique<Orderbook>(false, memory_));
+    }
+}
+
+BookPool::Lease BookPool::acquire() {
+    {
+        std::scoped_lock _{mutex_};
+        if (!idle_.empty()) {
+            Orderbook *book = idle_.back().release();
+            idle_.pop_back();
+            return Lease{book, Returner{this}};
+        }
+    }
+    return Lease{new Orderbook(false, memory_), Returner{this}};
+}
+
+std::size_t BookPool::idle() const {
+    std::scoped_lock _{mutex_};
+    return idle_.size();
+}
+
+void BookPool::release(Orderbook *book) {
+    std::unique_ptr<Orderbook> owned{book};
+    owned->reset();
+
+    std::scoped_lock _{mutex_};
+    idle_.push_back(std::move(owned));
+}
@@ -0,0 +1,42 @@
+#ifndef ORDERBOOK_BOOKPOOL_H
+#define ORDERBOOK_BOOKPOOL_H
+
+#include "Orderbook.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Recycles Orderbooks across backtest runs. A returned book is reset() by the releasing thread
+// and handed out again warm, instead of paying for a fresh 120k-slot construction and teardown.
+// Pooled books never start the GFD prune thread. Leases must not outlive the pool.
+class BookPool {
+public:
+    struct Returner {
+        BookPool *pool;
+
+        void operator()(Orderbook *book) const { pool->release(book); }
+    };
+
+    using Lease = std::unique_ptr<Orderbook, Returner>;
+
+    explicit BookPool(const MemoryOptions &memory = {}, std::size_t prewarm = 0);
+
+    BookPool(const BookPool &) = delete;
+
+    BookPool &operator=(const BookPool &) = delete;
+
+    [[nodiscard]] Lease acquire();
+
+    [[nodiscard]] std::size_t idle() const;
+
+private:
+    void release(Orderbook *book);
+
+    MemoryOptions memory_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Orderbook> > idle_;
+};
+
+#endif //ORDERBOOK_BOOKPOOL_H
@@ -0,0 +1,96 @@
+#include "ConflatingPublisher.h"
+
+#include <algorithm>
+#include <bit>
+
+ConflatingPublisher::ConflatingPublisher(std::size_t logCapacity)
+    : cells_{std::make_unique<LevelCell[]>(2 * Levels)},
+      log_{std::make_unique<std::atomic<std::uint32_t>[]>(std::bit_ceil(std::max<std::size_t>(logCapacity, 2)))},
+      logMask_{std::bit_ceil(std::max<std::size_t>(logCapacity, 2)) - 1} {
+}
+
+void ConflatingPublisher::publish(Side side, Price price, const LevelData &data) {
+    const std::size_t key = keyOf(side, price);
+    const std::uint64_t sequence = head_.load(std::memory_order_relaxed) + 1;
+    auto &cell = cells_[key];
+
+    cell.version.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    cell.quantity.store(data.quantity, std::memory_order_relaxed);
+    cell.count.store(data.count, std::memory_order_relaxed);
+    cell.version.store(2 * sequence, std::memory_order_release);
+
+    log_[(sequence - 1) & logMask_].store(static_cast<std::uint32_t>(key), std::memory_order_relaxed);
+    head_.store(sequence, std::memory_order_release);
+}
+
+std::uint64_t ConflatingPublisher::read(std::size_t key, Quantity &quantity, Quantity &count) const {
+    const auto &cell = cells_[key];
+    while (true) {
+        const std::uint64_t before = cell.version.load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        quantity = cell.quantity.load(std::memory_order_relaxed);
+        count = cell.count.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (cell.version.load(std::memory_order_relaxed) == before) return before / 2;
+    }
+}
+
+ConflatingConsumer::ConflatingConsumer(const ConflatingPublisher &publisher)
+    : publisher_{&publisher}, dirtyBits_((2 * ConflatingPublisher::Levels + 63) / 64) {
+}
+
+std::size_t ConflatingConsumer::pull(std::vector<LevelUpdate> &out) {
+    const auto &pub = *publisher_;
+    const std::size_t logCapacity = pub.logMask_ + 1;
+
+    const std::uint64_t head = pub.head_.load(std::memory_order_acquire);
+    if (head == cursor_) return 0;
+    if (head - cursor_ > logCapacity) return resync(out, head);
+
+    for (std::uint64_t pos = cursor_; pos != head; ++pos) {
+        const std::uint32_t key = pub.log_[pos & pub.logMask_].load(std::memory_order_relaxed);
+        auto &word = dirtyBits_[key / 64];
+        const std::uint64_t bit = std::uint64_t{1} << (key % 64);
+        if (!(word & bit)) {
+            word |= bit;
+            dirtyKeys_.push_back(key);
+        }
+    }
+
+    // The producer may have lapped us while we were reading the log.
+    const std::uint64_t after = pub.head_.load(std::memory_order_acquire);
+    if (after - cursor_ > logCapacity) {
+        for (const auto key: dirtyKeys_) dirtyBits_[key / 64] = 0;
+        dirtyKeys_.clear();
+        return resync(out, after);
+    }
+    cursor_ = head;
+
+    for (const auto key: dirtyKeys_) {
+        dirtyBits_[key / 64] &= ~(std::uint64_t{1} << (key % 64));
+        Quantity quantity, count;
+        const std::uint64_t sequence = pub.read(key, quantity, count);
+        out.push_back(ConflatingPublisher::updateFor(key, sequence, quantity, count));
+    }
+    const std::size_t pulled = dirtyKeys_.size();
+    dirtyKeys_.clear();
+    return pulled;
+}
+
+std::size_t ConflatingConsumer::resync(std::vector<LevelUpdate> &out, std::uint64_t head) {
+    ++resyncs_;
+    std::size_t pulled = 0;
+    for (std::size_t key = 0; key < 2 * ConflatingPublisher::Levels; ++key) {
+        Quantity quantity, count;
+        const std::uint64_t sequence = publisher_->read(key, quantity, count);
+        if (sequence > cursor_) {
+            out.push_back(ConflatingPublisher::updateFor(key, sequence, quantity, count));
+            ++pulled;
+        }
+    }
+    cursor_ = head;
+    return pulled;
+}
@@ -0,0 +1,86 @@
+#ifndef ORDERBOOK_CONFLATINGPUBLISHER_H
+#define ORDERBOOK_CONFLATINGPUBLISHER_H
+
+#include "Constants.h"
+#include "LevelData.h"
+#include "LevelUpdate.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ConflatingConsumer;
+
+// Broadcasts level changes to any number of consumers without ever waiting on them.
+// The producer keeps a seqlocked image of every level plus a fixed-size change log of level keys.
+// Each consumer drains the log at its own pace, keeping only the latest value per level; if it
+// falls more than a full log behind, it resyncs from the image instead of queueing.
+class ConflatingPublisher {
+public:
+    explicit ConflatingPublisher(std::size_t logCapacity = Constants::CONFLATION_LOG_CAPACITY);
+
+    ConflatingPublisher(const ConflatingPublisher &) = delete;
+
+    ConflatingPublisher &operator=(const ConflatingPublisher &) = delete;
+
+    // Producer only. Records the level's latest state and appends it to the change log.
+    void publish(Side side, Price price, const LevelData &data);
+
+    [[nodiscard]] std::uint64_t sequence() const { return head_.load(std::memory_order_acquire); }
+
+private:
+    friend class ConflatingConsumer;
+
+    static constexpr std::size_t Levels = Constants::LEVELARRAY_SIZE;
+
+    struct LevelCell {
+        // 2 * sequence of the last write; odd while a write is in progress.
+        std::atomic<std::uint64_t> version{0};
+        std::atomic<Quantity> quantity{0};
+        std::atomic<Quantity> count{0};
+    };
+
+    static std::size_t keyOf(Side side, Price price) {
+        return (side == Side::Buy ? 0 : Levels) + static_cast<std::size_t>(price);
+    }
+
+    static LevelUpdate updateFor(std::size_t key, std::uint64_t sequence, Quantity quantity, Quantity count) {
+        const bool buy = key < Levels;
+        return {
+            sequence, quantity, count, static_cast<Price>(buy ? key : key - Levels), buy ? Side::Buy : Side::Sell
+        };
+    }
+
+    // Reads a stable copy of one cell; returns its sequence.
+    std::uint64_t read(std::size_t key, Quantity &quantity, Quantity &count) const;
+
+    std::unique_ptr<LevelCell[]> cells_;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> log_;
+    std::size_t logMask_;
+    std::atomic<std::uint64_t> head_{0};
+};
+
+// One slow reader of a ConflatingPublisher. Memory is fixed at one bit and one key per level.
+class ConflatingConsumer {
+public:
+    explicit ConflatingConsumer(const ConflatingPublisher &publisher);
+
+    // Appends one update per level changed since the previous pull, carrying that level's
+    // latest quantity and count. Returns the number of updates appended.
+    std::size_t pull(std::vector<LevelUpdate> &out);
+
+    [[nodiscard]] std::uint64_t resyncs() const { return resyncs_; }
+
+private:
+    std::size_t resync(std::vector<LevelUpdate> &out, std::uint64_t head);
+
+    const ConflatingPublisher *publisher_;
+    std::uint64_t cursor_{0};
+    std::uint64_t resyncs_{0};
+    std::vector<std::uint64_t> dirtyBits_;
+    std::vector<std::uint32_t> dirtyKeys_;
+};
+
+#endif //ORDERBOOK_CONFLATINGPUBLISHER_H
@@ -5,6 +5,8 @@
 #ifndef ORDERBOOK_CONSTANTS_H
 #define ORDERBOOK_CONSTANTS_H
 
+#include <cstddef>
+#include <limits>
 #include <numeric>
 #include "Usings.h"
 
@@ -17,8 +19,14 @@ namespace Constants {
 
     auto constexpr inline INVALID_PRICE = std::numeric_limits<Price>::min();
     auto constexpr inline TICK_MULTIPLIER = 100;
+    OwnerId constexpr inline NO_OWNER = 0;
     size_t constexpr inline LEVELARRAY_SIZE = 60000;
     size_t constexpr inline INITIAL_ORDER_CAPACITY = 200'000;
+    size_t constexpr inline L2_FEED_CAPACITY = 1 << 16;
+    size_t constexpr inline EXECUTION_FEED_CAPACITY = 1 << 16;
+    size_t constexpr inline CONFLATION_LOG_CAPACITY = 1 << 14;
+    size_t constexpr inline REPLICATION_RING_CAPACITY = 1 << 20;
+    size_t constexpr inline MARKET_DATA_DEPTH = 10;
     TimeOfDay constexpr inline MarketCloseTime{16, 30, 00};
 }
 #endif //ORDERBOOK_CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef ORDERBOOK_DEPTHSNAPSHOT_H
+#define ORDERBOOK_DEPTHSNAPSHOT_H
+
+#include "LevelData.h"
+#include "OrderbookLevelInfos.h"
+#include "Side.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Immutable full-depth view. Readers hold it through a shared_ptr, so the book can publish
+// newer ones while older ones are still being walked.
+struct DepthSnapshot {
+    std::uint64_t version;
+    OrderbookLevelInfos levels;
+};
+
+// Writer-side sorted copy of the non-empty levels, kept current from the coalesced level
+// changes so a snapshot costs one copy of the depth instead of a walk over every order.
+class DepthImage {
+public:
+    void apply(Side side, Price price, const LevelData &data) {
+        auto &levels = side == Side::Buy ? bids_ : asks_;
+        const auto it = side == Side::Buy
+                            ? std::ranges::lower_bound(levels, price, std::greater{}, &LevelInfo::price)
+                            : std::ranges::lower_bound(levels, price, std::less{}, &LevelInfo::price);
+        const bool present = it != levels.end() && it->price == price;
+
+        if (data.count == 0) {
+            if (present) levels.erase(it);
+        } else if (present) {
+            it->quantity = data.quantity;
+        } else {
+            levels.insert(it, LevelInfo{price, data.quantity});
+        }
+    }
+
+    [[nodiscard]] const LevelInfos &bids() const { return bids_; }
+
+    [[nodiscard]] const LevelInfos &asks() const { return asks_; }
+
+private:
+    LevelInfos bids_;
+    LevelInfos asks_;
+};
+
+// Count, mean and max of a latency in nanoseconds. Safe to record from several threads.
+class LatencyStat {
+public:
+    void record(std::uint64_t ns) {
+        count_.fetch_add(1, std::memory_order_relaxed);
+        totalNs_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t max = maxNs_.load(std::memory_order_relaxed);
+        while (ns > max && !maxNs_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    [[nodiscard]] std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint64_t maxNs() const { return maxNs_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] double averageNs() const {
+        const std::uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(totalNs_.load(std::memory_order_relaxed)) / n;
+    }
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> totalNs_{0};
+    std::atomic<std::uint64_t> maxNs_{0};
+};
+
+struct SnapshotMetrics {
+    // getDepthSnapshot() calls, and those answered with an older snapshot because the book was busy.
+    std::uint64_t reads;
+    std::uint64_t staleReads;
+    double readerAverageNs;
+    std::uint64_t readerMaxNs;
+
+    // Snapshots built, and the time the book lock was held building them.
+    std::uint64_t publishes;
+    double writerStallAverageNs;
+    std::uint64_t writerStallMaxNs;
+};
+
+#endif //ORDERBOOK_DEPTHSNAPSHOT_H
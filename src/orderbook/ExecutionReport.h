@@ -0,0 +1,47 @@
+#ifndef ORDERBOOK_EXECUTIONREPORT_H
+#define ORDERBOOK_EXECUTIONREPORT_H
+
+#include "Usings.h"
+#include "Side.h"
+
+#include <cstdint>
+
+// L3 event for a single order. lastQuantity and counterpartyId are only set on fills.
+struct ExecutionReport {
+    enum class Type : std::uint8_t {
+        Accepted,
+        PartiallyFilled,
+        Filled,
+        Cancelled,
+        Replaced,
+        Expired,
+        Killed,
+        Rejected,
+        Triggered
+    };
+
+    enum class Reason : std::uint8_t {
+        None,
+        DuplicateId,
+        ZeroQuantity,
+        PriceOutOfRange,
+        NoLiquidity,
+        NotMarketable,
+        NotFullyFillable,
+        AuctionInProgress
+    };
+
+    std::uint64_t sequence{};
+    OrderId orderId{};
+    OrderId counterpartyId{};
+    Quantity lastQuantity{};
+    Quantity leavesQuantity{};
+    Price price{};
+    Type type{};
+    Reason reason{};
+    Side side{};
+
+    friend bool operator==(const ExecutionReport &a, const ExecutionReport &b) = default;
+};
+
+#endif //ORDERBOOK_EXECUTIONREPORT_H
@@ -0,0 +1,42 @@
+#ifndef ORDERBOOK_FEED_H
+#define ORDERBOOK_FEED_H
+
+#include "LevelUpdate.h"
+#include "ExecutionReport.h"
+#include "shared/SpscRing.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Per-book outbound stream. The book publishes under its own lock and never waits: when the
+// consumer falls a full ring behind, messages are dropped and show up as a sequence gap.
+template<class Message>
+class Feed {
+public:
+    explicit Feed(std::size_t capacity) : ring_{capacity} {
+    }
+
+    void publish(const Message &message) {
+        if (!ring_.tryPush(message)) [[unlikely]] {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template<class F>
+    std::size_t poll(F &&f) { return ring_.drain(std::forward<F>(f)); }
+
+    bool tryPop(Message &out) { return ring_.tryPop(out); }
+
+    [[nodiscard]] std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<Message> ring_;
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+using L2Feed = Feed<LevelUpdate>;
+using ExecutionFeed = Feed<ExecutionReport>;
+
+#endif //ORDERBOOK_FEED_H
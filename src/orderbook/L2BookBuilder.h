@@ -0,0 +1,67 @@
+#ifndef ORDERBOOK_L2BOOKBUILDER_H
+#define ORDERBOOK_L2BOOKBUILDER_H
+
+#include "LevelData.h"
+#include "LevelInfo.h"
+#include "LevelUpdate.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+
+// Consumer-side depth rebuilt purely from LevelUpdates.
+class L2BookBuilder {
+public:
+    // Returns false if the update does not directly follow the previous one; the depth is then
+    // stale until reset() and a fresh subscription.
+    bool apply(const LevelUpdate &update) {
+        const bool inSequence = update.sequence == lastSequence_ + 1;
+        if (!inSequence) gap_ = true;
+        lastSequence_ = update.sequence;
+
+        if (update.side == Side::Buy) applyTo(bids_, update);
+        else applyTo(asks_, update);
+        return inSequence;
+    }
+
+    void reset() {
+        bids_.clear();
+        asks_.clear();
+        lastSequence_ = 0;
+        gap_ = false;
+    }
+
+    [[nodiscard]] bool hasGap() const { return gap_; }
+
+    [[nodiscard]] std::uint64_t lastSequence() const { return lastSequence_; }
+
+    [[nodiscard]] LevelInfos getBids() const { return toInfos(bids_); }
+
+    [[nodiscard]] LevelInfos getAsks() const { return toInfos(asks_); }
+
+    [[nodiscard]] const std::map<Price, LevelData, std::greater<> > &bidLevels() const { return bids_; }
+
+    [[nodiscard]] const std::map<Price, LevelData, std::less<> > &askLevels() const { return asks_; }
+
+private:
+    template<class Levels>
+    static void applyTo(Levels &levels, const LevelUpdate &update) {
+        if (update.count == 0) levels.erase(update.price);
+        else levels[update.price] = LevelData{update.quantity, update.count};
+    }
+
+    template<class Levels>
+    static LevelInfos toInfos(const Levels &levels) {
+        LevelInfos infos;
+        infos.reserve(levels.size());
+        for (const auto &[price, data]: levels) infos.push_back({price, data.quantity});
+        return infos;
+    }
+
+    std::map<Price, LevelData, std::greater<> > bids_;
+    std::map<Price, LevelData, std::less<> > asks_;
+    std::uint64_t lastSequence_{0};
+    bool gap_{false};
+};
+
+#endif //ORDERBOOK_L2BOOKBUILDER_H
@@ -3,12 +3,20 @@
 
 #include "Side.h"
 #include "LevelData.h"
+#include "LevelKernels.h"
+#include "OrderList.h"
+#include "SweepEstimate.h"
+#include "shared/MappedRegion.h"
 
-#include <array>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <optional>
+#include <span>
+#include <vector>
 
 template<Side S>
 struct BestScanPolicy;
@@ -40,7 +48,14 @@ class LevelArray {
     using P = BestScanPolicy<S>;
 
 public:
-    LevelArray() = default;
+    explicit LevelArray(OrderPool &pool, const MemoryOptions &memory = {})
+        : storage_{OrdersBytes + 2 * ColumnBytes, memory},
+          orders_{static_cast<Orders *>(storage_.data())},
+          quantities_{reinterpret_cast<Quantity *>(static_cast<std::byte *>(storage_.data()) + OrdersBytes)},
+          counts_{quantities_ + ColumnBytes / sizeof(Quantity)} {
+        // The mapping is zero-filled, which is already the empty state of both columns.
+        for (int i = 0; i < N; ++i) std::construct_at(&orders_[i])->attach(pool);
+    }
 
     LevelArray(const LevelArray &) = delete;
 
@@ -50,41 +65,46 @@ public:
         const int idx = priceToIndex(price);
         assert(idx >= 0 && idx < N && "Price out of LevelArray range");
         if (idx < 0 || idx >= N) [[unlikely]] return std::nullopt;
-        return levels_[idx].orders;
+        return orders_[idx];
     }
 
     [[nodiscard]] std::optional<std::reference_wrapper<const Orders> > getOrders(Price price) const {
         const int idx = priceToIndex(price);
         assert(idx >= 0 && idx < N && "Price out of LevelArray range");
         if (idx < 0 || idx >= N) [[unlikely]] return std::nullopt;
-        return levels_[idx].orders;
+        return orders_[idx];
     }
 
-    std::optional<std::reference_wrapper<LevelData> > getLevelData(Price price) {
+    [[nodiscard]] LevelData getLevelData(Price price) const {
         const int idx = priceToIndex(price);
         assert(idx >= 0 && idx < N && "Price out of LevelArray range");
-        if (idx < 0 || idx >= N) [[unlikely]] return std::nullopt;
-        return levels_[idx].data;
+        return {quantities_[idx], counts_[idx]};
     }
 
-    [[nodiscard]] std::optional<std::reference_wrapper<const LevelData> > getLevelData(Price price) const {
+    void updateLevelData(Price price, Quantity quantity, LevelData::Action action) {
         const int idx = priceToIndex(price);
         assert(idx >= 0 && idx < N && "Price out of LevelArray range");
-        if (idx < 0 || idx >= N) [[unlikely]] return std::nullopt;
-        return levels_[idx].data;
+
+        if (action == LevelData::Action::Add) {
+            ++counts_[idx];
+            quantities_[idx] += quantity;
+        } else {
+            if (action == LevelData::Action::Remove) --counts_[idx];
+            quantities_[idx] -= quantity;
+        }
     }
 
     std::optional<std::pair<Price, std::reference_wrapper<Orders> > > getBestOrders() {
         if (empty_) [[unlikely]] return std::nullopt;
         assert(bestIdx_ >= 0 && bestIdx_ < N);
-        return std::pair<Price, std::reference_wrapper<Orders> >{indexToPrice(bestIdx_), levels_[bestIdx_].orders};
+        return std::pair<Price, std::reference_wrapper<Orders> >{indexToPrice(bestIdx_), orders_[bestIdx_]};
     }
 
     [[nodiscard]] std::optional<std::pair<Price, std::reference_wrapper<const Orders> > > getBestOrders() const {
         if (empty_) [[unlikely]] return std::nullopt;
         assert(bestIdx_ >= 0 && bestIdx_ < N);
         return std::pair<Price, std::reference_wrapper<const Orders> >{
-            indexToPrice(bestIdx_), levels_[bestIdx_].orders
+            indexToPrice(bestIdx_), orders_[bestIdx_]
         };
     }
 
@@ -97,14 +117,14 @@ public:
     std::optional<std::pair<Price, std::reference_wrapper<Orders> > > getWorstOrders() {
         if (empty_) [[unlikely]] return std::nullopt;
         assert(worstIdx_ >= 0 && worstIdx_ < N);
-        return std::pair<Price, std::reference_wrapper<Orders> >{indexToPrice(worstIdx_), levels_[worstIdx_].orders};
+        return std::pair<Price, std::reference_wrapper<Orders> >{indexToPrice(worstIdx_), orders_[worstIdx_]};
     }
 
     [[nodiscard]] std::optional<std::pair<Price, std::reference_wrapper<const Orders> > > getWorstOrders() const {
         if (empty_) [[unlikely]] return std::nullopt;
         assert(worstIdx_ >= 0 && worstIdx_ < N);
         return std::pair<Price, std::reference_wrapper<const Orders> >{
-            indexToPrice(worstIdx_), levels_[worstIdx_].orders
+            indexToPrice(worstIdx_), orders_[worstIdx_]
         };
     }
 
@@ -115,10 +135,19 @@ public:
 
     [[nodiscard]] bool empty() const noexcept { return empty_; }
 
+    [[nodiscard]] static constexpr bool contains(Price price) noexcept {
+        return price >= 0 && price < N;
+    }
+
     void onOrderAdded(Price price) {
         const int idx = priceToIndex(price);
         assert(idx >= 0 && idx < N && "Price out of LevelArray range");
 
+        if (!touched_[idx]) [[unlikely]] {
+            touched_[idx] = true;
+            touchedLevels_.push_back(idx);
+        }
+
         if (empty_) {
             bestIdx_ = worstIdx_ = idx;
             empty_ = false;
@@ -142,25 +171,151 @@ public:
         if (removedWorst) updateWorstIdx();
     }
 
-    [[nodiscard]] bool canFullyFill(Price limitPrice, Quantity quantity) const {
-        if (empty_) return false;
+    // Level quantities in ascending price order, indexed by price.
+    [[nodiscard]] const Quantity *quantities() const noexcept { return quantities_; }
 
-        const int limitIdx = priceToIndex(limitPrice);
+    // Total quantity resting from the best level through price.
+    [[nodiscard]] Quantity quantityThrough(Price price) const {
+        if (empty_) return 0;
+        const auto [low, high] = spanFromBest(priceToIndex(price));
+        return low > high ? 0 : LevelKernels::active().sum(quantities_ + low, high - low + 1);
+    }
 
-        for (int i = bestIdx_;; i += P::step) {
-            const auto &slot = levels_[i];
-            if (!slot.orders.empty()) {
-                if (!P::better(i, limitIdx)) break;
+    // The first level, best first, at which the cumulative quantity reaches quantity.
+    [[nodiscard]] std::optional<Price> priceReaching(Quantity quantity) const {
+        if (empty_) return std::nullopt;
+        const int idx = reachingIdx(worstIdx_, quantity);
+        if (idx < 0) return std::nullopt;
+        return indexToPrice(idx);
+    }
+
+    // The cost of sweeping quantity from the best level. The vector search finds the last level
+    // reached, so the accumulation over the levels up to it runs without data-dependent branches.
+    [[nodiscard]] SweepEstimate estimateSweep(Quantity quantity) const {
+        if (quantity == 0) return {};
+        if (empty_) return {.requested = quantity};
+
+        const int reached = reachingIdx(worstIdx_, quantity);
+        const int last = reached < 0 ? worstIdx_ : reached;
+        SweepEstimate estimate{.requested = quantity};
+        for (int i = std::min(bestIdx_, last); i <= std::max(bestIdx_, last); ++i) {
+            const Quantity levelQuantity = quantities_[i];
+            estimate.filled += levelQuantity;
+            estimate.notional += levelQuantity * indexToPrice(i);
+            estimate.levels += levelQuantity != 0;
+        }
+        if (reached >= 0) {
+            estimate.notional -= (estimate.filled - quantity) * indexToPrice(reached);
+            estimate.filled = quantity;
+        }
+        estimate.worstPrice = indexToPrice(last);
+        return estimate;
+    }
 
-                const Quantity lvlQty = slot.data.quantity;
-                if (lvlQty >= quantity) return true;
-                quantity -= lvlQty;
+    // Fills out[i] with the cost of sweeping sizes[i] from the best level, for sizes in ascending
+    // order, in a single walk over the quantity column that stops once the largest size is met.
+    void estimateSweeps(std::span<const Quantity> sizes, std::span<SweepEstimate> out) const {
+        assert(out.size() >= sizes.size() && std::ranges::is_sorted(sizes));
+
+        std::size_t next = 0;
+        for (; next < sizes.size() && sizes[next] == 0; ++next) out[next] = {};
+
+        Quantity cumulative = 0;
+        Quantity notional = 0;
+        std::size_t levels = 0;
+        std::optional<Price> lastPrice;
+        if (!empty_ && next < sizes.size()) {
+            for (int i = bestIdx_;; i += P::step) {
+                if (const Quantity quantity = quantities_[i]) {
+                    const Price price = indexToPrice(i);
+                    ++levels;
+                    for (; next < sizes.size() && cumulative + quantity >= sizes[next]; ++next) {
+                        const Quantity size = sizes[next];
+                        out[next] = {size, size, notional + (size - cumulative) * price, price, levels};
+                    }
+                    if (next == sizes.size()) return;
+
+                    cumulative += quantity;
+                    notional += quantity * price;
+                    lastPrice = price;
+                }
+                if (i == worstIdx_) break;
             }
+        }
 
-            if (i == worstIdx_) break;
+        for (; next < sizes.size(); ++next) out[next] = {sizes[next], cumulative, notional, lastPrice, levels};
+    }
+
+    // Calls f(price, LevelData) for up to limit non-empty levels, best first.
+    template<class F>
+    void forEachTopLevel(std::size_t limit, F &&f) const {
+        if (empty_) return;
+
+        const auto &kernels = LevelKernels::active();
+        constexpr std::size_t Chunk = 64;
+        std::uint32_t found[Chunk];
+        int low = std::min(bestIdx_, worstIdx_);
+        int high = std::max(bestIdx_, worstIdx_);
+        while (limit > 0 && low <= high) {
+            const std::size_t want = std::min(limit, Chunk);
+            const std::size_t n = high - low + 1;
+            const std::size_t got = P::step > 0
+                                        ? kernels.firstNonZero(counts_ + low, n, want, found)
+                                        : kernels.lastNonZero(counts_ + low, n, want, found);
+            for (std::size_t k = 0; k < got; ++k) {
+                const int idx = low + static_cast<int>(found[k]);
+                f(indexToPrice(idx), LevelData{quantities_[idx], counts_[idx]});
+            }
+            if (got < want) return;
+
+            limit -= got;
+            const int last = low + static_cast<int>(found[got - 1]);
+            if constexpr (P::step > 0) low = last + 1;
+            else high = last - 1;
+        }
+    }
+
+    // Empties every level priced in [low, high], best first, handing each slot and order to f before the
+    // node is released. Best and worst are recomputed once at the end. Returns the number of orders removed.
+    template<class F>
+    std::size_t clearLevels(Price low, Price high, F &&f) {
+        if (empty_) return 0;
+
+        const int first = std::max({priceToIndex(low), std::min(bestIdx_, worstIdx_), 0});
+        const int last = std::min({priceToIndex(high), std::max(bestIdx_, worstIdx_), N - 1});
+        if (first > last) return 0;
+
+        std::size_t removed = 0;
+        for (int i = P::step > 0 ? first : last; i >= first && i <= last; i += P::step) {
+            auto &level = orders_[i];
+            if (level.empty()) continue;
+            removed += level.releaseAll(f);
+            quantities_[i] = counts_[i] = 0;
+        }
+
+        const bool clearedBest = bestIdx_ >= first && bestIdx_ <= last;
+        const bool clearedWorst = worstIdx_ >= first && worstIdx_ <= last;
+        if (clearedBest) updateBestIdx();
+        if (clearedWorst && !empty_) updateWorstIdx();
+        return removed;
+    }
+
+    // Empties every level used since the last reset, in time proportional to those levels.
+    // The orders' nodes are not released; the owning OrderPool must be reset with it.
+    void reset() {
+        for (const int idx: touchedLevels_) {
+            orders_[idx].reset();
+            quantities_[idx] = counts_[idx] = 0;
+            touched_[idx] = false;
         }
+        touchedLevels_.clear();
+        empty_ = true;
+        bestIdx_ = worstIdx_ = P::start(N);
+    }
 
-        return false;
+    [[nodiscard]] bool canFullyFill(Price limitPrice, Quantity quantity) const {
+        if (empty_) return false;
+        return reachingIdx(priceToIndex(limitPrice), quantity) >= 0;
     }
 
     template<class F>
@@ -168,17 +323,37 @@ public:
         if (empty_) return;
 
         for (int i = bestIdx_;; i += P::step) {
-            if (!levels_[i].orders.empty()) {
-                f(indexToPrice(i), levels_[i].orders);
+            if (!orders_[i].empty()) {
+                f(indexToPrice(i), orders_[i]);
             }
             if (i == worstIdx_) break;
         }
     }
 
 private:
+    // Index bounds of the levels from best through limitIdx, clamped at worst; low > high if none.
+    [[nodiscard]] std::pair<int, int> spanFromBest(int limitIdx) const {
+        if constexpr (P::step > 0) return {bestIdx_, std::min(limitIdx, worstIdx_)};
+        else return {std::max(limitIdx, worstIdx_), bestIdx_};
+    }
+
+    // Index of the level, scanning from best through limitIdx, at which the cumulative quantity
+    // reaches quantity; -1 if it never does.
+    [[nodiscard]] int reachingIdx(int limitIdx, Quantity quantity) const {
+        const auto [low, high] = spanFromBest(limitIdx);
+        if (low > high) return -1;
+
+        const auto &kernels = LevelKernels::active();
+        const std::size_t n = high - low + 1;
+        const std::size_t found = P::step > 0
+                                      ? kernels.firstCumulativeAtLeast(quantities_ + low, n, quantity)
+                                      : kernels.lastCumulativeAtLeast(quantities_ + low, n, quantity);
+        return found == n ? -1 : low + static_cast<int>(found);
+    }
+
     void updateBestIdx() {
         for (int i = bestIdx_;; i += P::step) {
-            if (!levels_[i].orders.empty()) {
+            if (!orders_[i].empty()) {
                 bestIdx_ = i;
                 empty_ = false;
                 return;
@@ -194,7 +369,7 @@ private:
         constexpr int backStep = -P::step;
 
         for (int i = worstIdx_;; i += backStep) {
-            if (!levels_[i].orders.empty()) {
+            if (!orders_[i].empty()) {
                 worstIdx_ = i;
                 empty_ = false;
                 return;
@@ -215,12 +390,22 @@ private:
     }
 
 private:
-    struct LevelSlot {
-        Orders orders{};
-        LevelData data{};
-    };
-
-    std::array<LevelSlot, N> levels_{};
+    static constexpr std::size_t alignToLine(std::size_t bytes) { return (bytes + 63) & ~std::size_t{63}; }
+
+    static constexpr std::size_t OrdersBytes = alignToLine(sizeof(Orders) * N);
+    static constexpr std::size_t ColumnBytes = alignToLine(sizeof(Quantity) * N);
+
+    // One mapping holds three price-indexed columns: the FIFOs, then the level quantities, then
+    // the order counts. Keeping quantities and counts apart from the FIFOs lets depth queries
+    // stream through them with vector loads. Orders is trivially destructible, so the mapping
+    // is simply dropped on destruction.
+    MappedRegion storage_;
+    Orders *orders_;
+    Quantity *quantities_;
+    Quantity *counts_;
+
+    std::vector<bool> touched_ = std::vector<bool>(N);
+    std::vector<int> touchedLevels_;
 
     int bestIdx_{P::start(N)};
     int worstIdx_{P::start(N)};
@@ -6,6 +6,7 @@
 #define ORDERBOOK_LEVELINFO_H
 
 #include "Usings.h"
+#include <ostream>
 
 struct LevelInfo {
     Price price;
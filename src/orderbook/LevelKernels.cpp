@@ -0,0 +1,333 @@
+#include "LevelKernels.h"
+
+#include <bit>
+
+#include <immintrin.h>
+
+namespace LevelKernels {
+    namespace {
+        // ===== Scalar =====
+
+        void prefixSumScalar(const Quantity *in, Quantity *out, std::size_t n) {
+            Quantity running = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                running += in[i];
+                out[i] = running;
+            }
+        }
+
+        Quantity sumScalar(const Quantity *values, std::size_t n) {
+            Quantity total = 0;
+            for (std::size_t i = 0; i < n; ++i) total += values[i];
+            return total;
+        }
+
+        // The SIMD searches skip whole blocks that leave the total short, then finish here.
+        std::size_t firstCumulativeFrom(const Quantity *values, std::size_t i, std::size_t n, Quantity running,
+                                        Quantity target) {
+            for (; i < n; ++i) {
+                running += values[i];
+                if (running >= target) return i;
+            }
+            return n;
+        }
+
+        std::size_t lastCumulativeFrom(const Quantity *values, std::size_t end, std::size_t n, Quantity running,
+                                       Quantity target) {
+            while (end > 0) {
+                running += values[--end];
+                if (running >= target) return end;
+            }
+            return n;
+        }
+
+        std::size_t firstCumulativeScalar(const Quantity *values, std::size_t n, Quantity target) {
+            return firstCumulativeFrom(values, 0, n, 0, target);
+        }
+
+        std::size_t lastCumulativeScalar(const Quantity *values, std::size_t n, Quantity target) {
+            return lastCumulativeFrom(values, n, n, 0, target);
+        }
+
+        // Ascending scan of [i, n) appending to out[found..limit).
+        std::size_t firstNonZeroFrom(const Quantity *values, std::size_t i, std::size_t n, std::size_t found,
+                                     std::size_t limit, std::uint32_t *out) {
+            for (; i < n && found < limit; ++i) {
+                if (values[i]) out[found++] = static_cast<std::uint32_t>(i);
+            }
+            return found;
+        }
+
+        // Descending scan of [0, end) appending to out[found..limit).
+        std::size_t lastNonZeroFrom(const Quantity *values, std::size_t end, std::size_t found, std::size_t limit,
+                                    std::uint32_t *out) {
+            while (end > 0 && found < limit) {
+                if (values[--end]) out[found++] = static_cast<std::uint32_t>(end);
+            }
+            return found;
+        }
+
+        std::size_t firstNonZeroScalar(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            return firstNonZeroFrom(values, 0, n, 0, limit, out);
+        }
+
+        std::size_t lastNonZeroScalar(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            return lastNonZeroFrom(values, n, 0, limit, out);
+        }
+
+        // Appends base + the set bits of a block mask, lowest or highest first.
+        std::size_t emitAscending(std::uint32_t mask, std::size_t base, std::size_t found, std::size_t limit,
+                                  std::uint32_t *out) {
+            for (; mask && found < limit; mask &= mask - 1) {
+                out[found++] = static_cast<std::uint32_t>(base + std::countr_zero(mask));
+            }
+            return found;
+        }
+
+        std::size_t emitDescending(std::uint32_t mask, std::size_t base, std::size_t found, std::size_t limit,
+                                   std::uint32_t *out) {
+            while (mask && found < limit) {
+                const int top = 31 - std::countl_zero(mask);
+                out[found++] = static_cast<std::uint32_t>(base + top);
+                mask &= ~(std::uint32_t{1} << top);
+            }
+            return found;
+        }
+
+        // ===== AVX2: 4 x uint64 per register =====
+
+        __attribute__((target("avx2")))
+        __m256i load4(const Quantity *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+
+        __attribute__((target("avx2")))
+        Quantity horizontalSum4(__m256i v) {
+            const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+            return static_cast<Quantity>(_mm_cvtsi128_si64(s)) + static_cast<Quantity>(_mm_extract_epi64(s, 1));
+        }
+
+        __attribute__((target("avx2")))
+        std::uint32_t nonZeroMask4(const Quantity *p) {
+            const __m256i isZero = _mm256_cmpeq_epi64(load4(p), _mm256_setzero_si256());
+            return ~static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(isZero))) & 0xF;
+        }
+
+        // Two shift-and-add steps scan within the register, then the previous block's total is
+        // added to every lane and the new total broadcast from the top lane.
+        __attribute__((target("avx2")))
+        void prefixSumAvx2(const Quantity *in, Quantity *out, std::size_t n) {
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i carry = zero;
+
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i x = load4(in + i);
+                // [0, x0, x1, x2]
+                x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero, 0x03));
+                // [0, 0, x0, x1]
+                x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), zero, 0x0F));
+                x = _mm256_add_epi64(x, carry);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), x);
+                carry = _mm256_permute4x64_epi64(x, 0xFF);
+            }
+
+            Quantity running = i == 0 ? 0 : out[i - 1];
+            for (; i < n; ++i) {
+                running += in[i];
+                out[i] = running;
+            }
+        }
+
+        __attribute__((target("avx2")))
+        Quantity sumAvx2(const Quantity *values, std::size_t n) {
+            __m256i a = _mm256_setzero_si256();
+            __m256i b = _mm256_setzero_si256();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                a = _mm256_add_epi64(a, load4(values + i));
+                b = _mm256_add_epi64(b, load4(values + i + 4));
+            }
+            for (; i + 4 <= n; i += 4) a = _mm256_add_epi64(a, load4(values + i));
+            return horizontalSum4(_mm256_add_epi64(a, b)) + sumScalar(values + i, n - i);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t firstCumulativeAvx2(const Quantity *values, std::size_t n, Quantity target) {
+            Quantity running = 0;
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const Quantity block = horizontalSum4(load4(values + i));
+                if (running + block >= target) break;
+                running += block;
+            }
+            return firstCumulativeFrom(values, i, n, running, target);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t lastCumulativeAvx2(const Quantity *values, std::size_t n, Quantity target) {
+            Quantity running = 0;
+            std::size_t end = n;
+            for (; end >= 4; end -= 4) {
+                const Quantity block = horizontalSum4(load4(values + end - 4));
+                if (running + block >= target) break;
+                running += block;
+            }
+            return lastCumulativeFrom(values, end, n, running, target);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t firstNonZeroAvx2(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            std::size_t found = 0;
+            std::size_t i = 0;
+            for (; i + 4 <= n && found < limit; i += 4) {
+                found = emitAscending(nonZeroMask4(values + i), i, found, limit, out);
+            }
+            return firstNonZeroFrom(values, i, n, found, limit, out);
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t lastNonZeroAvx2(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            std::size_t found = 0;
+            std::size_t end = n;
+            for (; end >= 4 && found < limit; end -= 4) {
+                found = emitDescending(nonZeroMask4(values + end - 4), end - 4, found, limit, out);
+            }
+            return lastNonZeroFrom(values, end, found, limit, out);
+        }
+
+        // ===== AVX-512: 8 x uint64 per register =====
+
+        __attribute__((target("avx512f")))
+        __m512i load8(const Quantity *p) { return _mm512_loadu_si512(p); }
+
+        // By hand: in GCC 12, _mm512_reduce_add_epi64 and the unmasked extracts start from an
+        // undefined register and trip -Wuninitialized; the zero-masked extracts do not.
+        __attribute__((target("avx512f")))
+        Quantity horizontalSum8(__m512i v) {
+            return horizontalSum4(_mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xff, v, 0),
+                                                   _mm512_maskz_extracti64x4_epi64(0xff, v, 1)));
+        }
+
+        __attribute__((target("avx512f")))
+        Quantity sumAvx512(const Quantity *values, std::size_t n) {
+            __m512i a = _mm512_setzero_si512();
+            __m512i b = _mm512_setzero_si512();
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                a = _mm512_add_epi64(a, load8(values + i));
+                b = _mm512_add_epi64(b, load8(values + i + 8));
+            }
+            for (; i + 8 <= n; i += 8) a = _mm512_add_epi64(a, load8(values + i));
+            return horizontalSum8(_mm512_add_epi64(a, b)) +
+                   sumScalar(values + i, n - i);
+        }
+
+        __attribute__((target("avx512f")))
+        std::size_t firstCumulativeAvx512(const Quantity *values, std::size_t n, Quantity target) {
+            Quantity running = 0;
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const Quantity block = horizontalSum8(load8(values + i));
+                if (running + block >= target) break;
+                running += block;
+            }
+            return firstCumulativeFrom(values, i, n, running, target);
+        }
+
+        __attribute__((target("avx512f")))
+        std::size_t lastCumulativeAvx512(const Quantity *values, std::size_t n, Quantity target) {
+            Quantity running = 0;
+            std::size_t end = n;
+            for (; end >= 8; end -= 8) {
+                const Quantity block = horizontalSum8(load8(values + end - 8));
+                if (running + block >= target) break;
+                running += block;
+            }
+            return lastCumulativeFrom(values, end, n, running, target);
+        }
+
+        __attribute__((target("avx512f")))
+        std::uint32_t nonZeroMask8(const Quantity *p) {
+            const __m512i v = load8(p);
+            return _mm512_test_epi64_mask(v, v);
+        }
+
+        __attribute__((target("avx512f")))
+        std::size_t firstNonZeroAvx512(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            std::size_t found = 0;
+            std::size_t i = 0;
+            for (; i + 8 <= n && found < limit; i += 8) {
+                found = emitAscending(nonZeroMask8(values + i), i, found, limit, out);
+            }
+            return firstNonZeroFrom(values, i, n, found, limit, out);
+        }
+
+        __attribute__((target("avx512f")))
+        std::size_t lastNonZeroAvx512(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out) {
+            std::size_t found = 0;
+            std::size_t end = n;
+            for (; end >= 8 && found < limit; end -= 8) {
+                found = emitDescending(nonZeroMask8(values + end - 8), end - 8, found, limit, out);
+            }
+            return lastNonZeroFrom(values, end, found, limit, out);
+        }
+
+        // The prefix sum is carried lane to lane, so wider registers buy little: AVX-512 reuses AVX2's.
+        constexpr Kernels ScalarKernels{
+            prefixSumScalar, sumScalar, firstCumulativeScalar, lastCumulativeScalar,
+            firstNonZeroScalar, lastNonZeroScalar
+        };
+        constexpr Kernels Avx2Kernels{
+            prefixSumAvx2, sumAvx2, firstCumulativeAvx2, lastCumulativeAvx2,
+            firstNonZeroAvx2, lastNonZeroAvx2
+        };
+        constexpr Kernels Avx512Kernels{
+            prefixSumAvx2, sumAvx512, firstCumulativeAvx512, lastCumulativeAvx512,
+            firstNonZeroAvx512, lastNonZeroAvx512
+        };
+    }
+
+    bool supported(Isa isa) {
+        switch (isa) {
+            case Isa::Scalar:
+                return true;
+            case Isa::Avx2:
+                return __builtin_cpu_supports("avx2");
+            case Isa::Avx512:
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2");
+        }
+        return false;
+    }
+
+    const char *name(Isa isa) {
+        switch (isa) {
+            case Isa::Scalar:
+                return "scalar";
+            case Isa::Avx2:
+                return "avx2";
+            case Isa::Avx512:
+                return "avx512";
+        }
+        return "unknown";
+    }
+
+    const Kernels &kernels(Isa isa) {
+        switch (isa) {
+            case Isa::Avx2:
+                return Avx2Kernels;
+            case Isa::Avx512:
+                return Avx512Kernels;
+            default:
+                return ScalarKernels;
+        }
+    }
+
+    Isa bestIsa() {
+        static const Isa best = supported(Isa::Avx512) ? Isa::Avx512 : supported(Isa::Avx2) ? Isa::Avx2 : Isa::Scalar;
+        return best;
+    }
+
+    const Kernels &active() {
+        static const Kernels &chosen = kernels(bestIsa());
+        return chosen;
+    }
+}
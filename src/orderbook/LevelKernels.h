@@ -0,0 +1,50 @@
+#ifndef ORDERBOOK_LEVELKERNELS_H
+#define ORDERBOOK_LEVELKERNELS_H
+
+#include "Usings.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized loops over contiguous per-level quantities or counts. Every kernel exists as scalar,
+// AVX2 and AVX-512 code built with target attributes, so the build needs no -march flags;
+// active() picks the widest set the CPU supports, once.
+namespace LevelKernels {
+    enum class Isa : std::uint8_t {
+        Scalar,
+        Avx2,
+        Avx512
+    };
+
+    struct Kernels {
+        // out[i] = in[0] + ... + in[i]. in and out may be the same buffer.
+        void (*inclusivePrefixSum)(const Quantity *in, Quantity *out, std::size_t n);
+
+        Quantity (*sum)(const Quantity *values, std::size_t n);
+
+        // Smallest i with values[0] + ... + values[i] >= target, or n if the total falls short.
+        std::size_t (*firstCumulativeAtLeast)(const Quantity *values, std::size_t n, Quantity target);
+
+        // Largest i with values[i] + ... + values[n - 1] >= target, or n if the total falls short.
+        std::size_t (*lastCumulativeAtLeast)(const Quantity *values, std::size_t n, Quantity target);
+
+        // Indices of the first (ascending) or last (descending) non-zero values, at most limit of
+        // them, written to out. Returns how many were written.
+        std::size_t (*firstNonZero)(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out);
+
+        std::size_t (*lastNonZero)(const Quantity *values, std::size_t n, std::size_t limit, std::uint32_t *out);
+    };
+
+    [[nodiscard]] bool supported(Isa isa);
+
+    [[nodiscard]] const char *name(Isa isa);
+
+    // The kernels for one instruction set; only call them if supported(isa).
+    [[nodiscard]] const Kernels &kernels(Isa isa);
+
+    [[nodiscard]] Isa bestIsa();
+
+    [[nodiscard]] const Kernels &active();
+}
+
+#endif //ORDERBOOK_LEVELKERNELS_H
@@ -0,0 +1,18 @@
+#ifndef ORDERBOOK_LEVELUPDATE_H
+#define ORDERBOOK_LEVELUPDATE_H
+
+#include "Usings.h"
+#include "Side.h"
+
+// L2 delta: the state of one price level after an event. A count of zero means the level is gone.
+struct LevelUpdate {
+    std::uint64_t sequence{};
+    Quantity quantity{};
+    Quantity count{};
+    Price price{};
+    Side side{};
+
+    friend bool operator==(const LevelUpdate &a, const LevelUpdate &b) = default;
+};
+
+#endif //ORDERBOOK_LEVELUPDATE_H
@@ -0,0 +1,36 @@
+#include "MarketData.h"
+
+#include <memory>
+#include <stdexcept>
+
+MarketDataSegment::MarketDataSegment(SharedMemory memory, MarketDataHeader *header)
+    : memory_{std::move(memory)}, header_{header} {
+}
+
+MarketDataSegment MarketDataSegment::create(const std::string &name, std::size_t symbols) {
+    SharedMemory memory = SharedMemory::create(name, MarketDataHeader::bytesFor(symbols));
+    auto *header = std::construct_at(static_cast<MarketDataHeader *>(memory.data()));
+    header->magic = MarketDataHeader::Magic;
+    header->version = MarketDataHeader::Version;
+    header->slotSize = sizeof(QuoteSlot);
+    header->depth = Quote::Depth;
+    header->symbols = static_cast<std::uint32_t>(symbols);
+    for (std::size_t i = 0; i < symbols; ++i) std::construct_at(header->slots() + i);
+    return {std::move(memory), header};
+}
+
+MarketDataSegment MarketDataSegment::open(const std::string &name) {
+    SharedMemory memory = SharedMemory::open(name);
+    auto *header = static_cast<MarketDataHeader *>(memory.data());
+    if (memory.size() < MarketDataHeader::SlotsOffset || header->magic != MarketDataHeader::Magic ||
+        header->version != MarketDataHeader::Version || header->slotSize != sizeof(QuoteSlot) ||
+        header->depth != Quote::Depth || memory.size() < MarketDataHeader::bytesFor(header->symbols)) {
+        throw std::runtime_error("Not a market data segment: " + name);
+    }
+    return {std::move(memory), header};
+}
+
+QuoteSlot &MarketDataSegment::slot(std::size_t symbol) const {
+    if (symbol >= header_->symbols) throw std::out_of_range("No market data slot for symbol " + std::to_string(symbol));
+    return header_->slots()[symbol];
+}
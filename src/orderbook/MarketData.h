@@ -0,0 +1,135 @@
+#ifndef ORDERBOOK_MARKETDATA_H
+#define ORDERBOOK_MARKETDATA_H
+
+#include "Constants.h"
+#include "Usings.h"
+#include "shared/SharedMemory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+struct QuoteLevel {
+    Price price;
+    std::uint32_t count;
+    Quantity quantity;
+};
+
+// The best MARKET_DATA_DEPTH levels of each side of one book, best first.
+struct Quote {
+    static constexpr std::size_t Depth = Constants::MARKET_DATA_DEPTH;
+
+    // The writer's sharedClockNs() when it published this quote.
+    std::uint64_t publishedNs;
+    std::uint32_t bidLevels;
+    std::uint32_t askLevels;
+    QuoteLevel bids[Depth];
+    QuoteLevel asks[Depth];
+
+    [[nodiscard]] std::optional<QuoteLevel> bestBid() const {
+        return bidLevels ? std::optional{bids[0]} : std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<QuoteLevel> bestAsk() const {
+        return askLevels ? std::optional{asks[0]} : std::nullopt;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<Quote> && sizeof(Quote) % sizeof(std::uint64_t) == 0);
+
+// One symbol's quote behind a seqlock. The single writer makes version odd, stores the quote and
+// makes it even again; readers copy the quote and retry if the version moved. The quote is held as
+// relaxed atomic words so a copy racing a write is well defined, just discarded.
+struct alignas(64) QuoteSlot {
+    static constexpr std::size_t Words = sizeof(Quote) / sizeof(std::uint64_t);
+
+    // Twice the number of quotes published; odd while a write is in progress.
+    std::atomic<std::uint64_t> version;
+    std::atomic<std::uint64_t> words[Words];
+
+    // Word by word rather than through a buffer: a small memcpy becomes rep movs, which costs more
+    // than the copy itself.
+    void store(const Quote &quote) {
+        const auto *source = reinterpret_cast<const std::byte *>(&quote);
+        const std::uint64_t v = version.load(std::memory_order_relaxed);
+        version.store(v + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < Words; ++i) {
+            std::uint64_t word;
+            std::memcpy(&word, source + i * sizeof word, sizeof word);
+            words[i].store(word, std::memory_order_relaxed);
+        }
+        version.store(v + 2, std::memory_order_release);
+    }
+
+    // Copies a consistent quote into out and returns its sequence (0 if none was published yet).
+    std::uint64_t load(Quote &out) const {
+        auto *target = reinterpret_cast<std::byte *>(&out);
+        for (;;) {
+            const std::uint64_t before = version.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            for (std::size_t i = 0; i < Words; ++i) {
+                const std::uint64_t word = words[i].load(std::memory_order_relaxed);
+                std::memcpy(target + i * sizeof word, &word, sizeof word);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) == before) return before / 2;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t sequence() const { return version.load(std::memory_order_acquire) / 2; }
+};
+
+// Layout of the shared memory object: this header, then one QuoteSlot per symbol from SlotsOffset.
+struct MarketDataHeader {
+    static constexpr std::uint64_t Magic = 0x4f42'5155'4f54'4553; // "OBQUOTES"
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::size_t SlotsOffset = 64;
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t slotSize;
+    std::uint32_t depth;
+    std::uint32_t symbols;
+
+    [[nodiscard]] QuoteSlot *slots() {
+        return reinterpret_cast<QuoteSlot *>(reinterpret_cast<std::byte *>(this) + SlotsOffset);
+    }
+
+    static std::size_t bytesFor(std::size_t symbols) { return SlotsOffset + symbols * sizeof(QuoteSlot); }
+};
+
+static_assert(sizeof(MarketDataHeader) <= MarketDataHeader::SlotsOffset);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "quote slots are shared between processes, so their words must be address-free");
+
+// A named segment of quote slots, one per symbol. The engine creates it and attaches each book to
+// its symbol's slot with Orderbook::publishMarketData; readers open it with MarketDataReader.
+class MarketDataSegment {
+public:
+    // Creates the shared memory object name with symbols empty slots. Throws std::system_error.
+    static MarketDataSegment create(const std::string &name, std::size_t symbols);
+
+    // Maps an existing segment. Throws std::system_error if it does not exist and
+    // std::runtime_error if it is not a quote segment.
+    static MarketDataSegment open(const std::string &name);
+
+    [[nodiscard]] std::size_t symbols() const { return header_->symbols; }
+
+    // Throws std::out_of_range for a symbol outside the segment.
+    [[nodiscard]] QuoteSlot &slot(std::size_t symbol) const;
+
+    [[nodiscard]] const std::string &name() const { return memory_.name(); }
+
+private:
+    MarketDataSegment(SharedMemory memory, MarketDataHeader *header);
+
+    SharedMemory memory_;
+    MarketDataHeader *header_;
+};
+
+#endif //ORDERBOOK_MARKETDATA_H
@@ -0,0 +1,15 @@
+#include "MarketDataReader.h"
+
+MarketDataReader::MarketDataReader(const std::string &name) : segment_{MarketDataSegment::open(name)} {
+}
+
+std::uint64_t MarketDataReader::read(std::size_t symbol, Quote &out) const {
+    return segment_.slot(symbol).load(out);
+}
+
+bool MarketDataReader::poll(std::size_t symbol, std::uint64_t &lastSequence, Quote &out) const {
+    const QuoteSlot &slot = segment_.slot(symbol);
+    if (slot.sequence() <= lastSequence) return false;
+    lastSequence = slot.load(out);
+    return true;
+}
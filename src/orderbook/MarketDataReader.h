@@ -0,0 +1,35 @@
+#ifndef ORDERBOOK_MARKETDATAREADER_H
+#define ORDERBOOK_MARKETDATAREADER_H
+
+#include "MarketData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read side of a MarketDataSegment, for strategies in other processes. Reads are plain loads from
+// the mapped slots: no syscalls, no locks, and the writer never waits for a reader. Links against
+// market_data_lib alone, without the matching engine.
+class MarketDataReader {
+public:
+    // Throws std::system_error if name does not exist and std::runtime_error if it is not a
+    // quote segment.
+    explicit MarketDataReader(const std::string &name);
+
+    [[nodiscard]] std::size_t symbols() const { return segment_.symbols(); }
+
+    // Number of quotes published for symbol so far; cheap enough to spin on.
+    [[nodiscard]] std::uint64_t sequence(std::size_t symbol) const { return segment_.slot(symbol).sequence(); }
+
+    // Copies the latest quote for symbol into out and returns its sequence, 0 if the book has not
+    // published yet. Throws std::out_of_range for a symbol outside the segment.
+    std::uint64_t read(std::size_t symbol, Quote &out) const;
+
+    // Copies the latest quote into out only if it is newer than lastSequence, which is then updated.
+    bool poll(std::size_t symbol, std::uint64_t &lastSequence, Quote &out) const;
+
+private:
+    MarketDataSegment segment_;
+};
+
+#endif //ORDERBOOK_MARKETDATAREADER_H
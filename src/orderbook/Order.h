@@ -11,16 +11,17 @@
 #include "Constants.h"
 #include <cassert>
 #include <iostream>
-#include <list>
+#include <utility>
 
 class Order {
 public:
-    Order(OrderId id, OrderType type, Side side, Price price, Quantity quantity)
-        : id_{id}, type_{type}, side_{side}, price_{price}, remainingQuantity_{quantity} {
+    Order(OrderId id, OrderType type, Side side, Price price, Quantity quantity,
+          OwnerId owner = Constants::NO_OWNER)
+        : id_{id}, remainingQuantity_{quantity}, price_{price}, owner_{owner}, type_{type}, side_{side} {
     }
 
-    Order(OrderId id, Side side, Quantity quantity) : Order(id, OrderType::Market, side, Constants::INVALID_PRICE,
-                                                            quantity) {
+    Order(OrderId id, Side side, Quantity quantity, OwnerId owner = Constants::NO_OWNER)
+        : Order(id, OrderType::Market, side, Constants::INVALID_PRICE, quantity, owner) {
     }
 
     [[nodiscard]] OrderId getId() const {
@@ -39,6 +40,10 @@ public:
         return price_;
     }
 
+    [[nodiscard]] OwnerId getOwner() const {
+        return owner_;
+    }
+
     [[nodiscard]] Quantity getRemainingQuantity() const {
         return remainingQuantity_;
     }
@@ -63,18 +68,17 @@ public:
     }
 
     friend std::ostream &operator<<(std::ostream &os, const Order &order) {
-        return os << order.id_ << "," << std::to_underlying(order.type_) << "," << std::to_underlying(order.side_)
+        return os << order.id_ << "," << +std::to_underlying(order.type_) << "," << +std::to_underlying(order.side_)
                << "," << order.price_ << "," << order.remainingQuantity_ << "\n";
     }
 
 private:
+    // Matching only touches the id and quantity, so they lead; the owner and one-byte enums pack the tail.
     OrderId id_{};
+    Quantity remainingQuantity_{};
+    Price price_{};
+    OwnerId owner_{};
     OrderType type_;
     Side side_;
-    Price price_{};
-    Quantity remainingQuantity_{};
 };
-
-using Orders = std::list<Order>;
-using OrdersIterator = std::list<Order>::iterator;
 #endif //ORDERBOOK_ORDER_H
\ No newline at end of file
@@ -0,0 +1,217 @@
+#ifndef ORDERBOOK_ORDERINDEX_H
+#define ORDERBOOK_ORDERINDEX_H
+
+#include "OrderPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Maps the id of every resting order to its OrderPool handle. Two policies share one interface;
+// the book uses OrderIndex, chosen at compile time with ORDERBOOK_DIRECT_ORDER_INDEX.
+// find() and extract() return an invalid handle for an unknown id; insert() expects a new one.
+
+class HashOrderIndex {
+public:
+    [[nodiscard]] OrderHandle find(OrderId id) const {
+        const auto it = slots_.find(id);
+        return it == slots_.end() ? OrderHandle{} : it->second;
+    }
+
+    [[nodiscard]] bool contains(OrderId id) const { return slots_.contains(id); }
+
+    void insert(OrderId id, OrderHandle handle) { slots_.emplace(id, handle); }
+
+    OrderHandle extract(OrderId id) {
+        const auto it = slots_.find(id);
+        if (it == slots_.end()) return {};
+        const OrderHandle handle = it->second;
+        slots_.erase(it);
+        return handle;
+    }
+
+    void erase(OrderId id) { slots_.erase(id); }
+
+    [[nodiscard]] std::size_t size() const { return slots_.size(); }
+
+    void reserve(std::size_t orders) { slots_.reserve(orders); }
+
+    // Range erase walks the k nodes; clear() would also zero every bucket.
+    void clear() { slots_.erase(slots_.begin(), slots_.end()); }
+
+    template<class F>
+    void forEach(F &&f) const {
+        for (const auto &[id, handle]: slots_) f(id, handle);
+    }
+
+private:
+    std::unordered_map<OrderId, OrderHandle> slots_;
+};
+
+// For ids handed out densely and roughly in order, as the generator and gateway do. A directory
+// of 4096-entry pages is indexed by (id - base) / 4096, so a lookup is a shift and two loads.
+// A page goes back to a free list once every id on it is dead, and dead pages at the front
+// advance the base. Ids below the base or too far above it fall back to a hash map, so any id
+// sequence is handled correctly, just not quickly.
+class DirectOrderIndex {
+public:
+    static constexpr std::size_t PageBits = 12;
+    static constexpr std::size_t PageSize = std::size_t{1} << PageBits;
+    // The directory never spans more than this many pages (512KB of pointers).
+    static constexpr std::size_t MaxPages = std::size_t{1} << 16;
+
+    DirectOrderIndex() = default;
+
+    DirectOrderIndex(const DirectOrderIndex &) = delete;
+
+    DirectOrderIndex &operator=(const DirectOrderIndex &) = delete;
+
+    [[nodiscard]] OrderHandle find(OrderId id) const {
+        const OrderId offset = id - base_;
+        const std::size_t page = offset >> PageBits;
+        if (page < directory_.size()) [[likely]] {
+            if (const Page *p = directory_[page]) {
+                const OrderHandle handle = p->handles[offset & (PageSize - 1)];
+                if (handle.valid() || overflow_.empty()) [[likely]] return handle;
+            }
+        }
+        return findOverflow(id);
+    }
+
+    [[nodiscard]] bool contains(OrderId id) const { return find(id).valid(); }
+
+    void insert(OrderId id, OrderHandle handle) {
+        ++size_;
+        if (directory_.empty()) base_ = id & ~OrderId{PageSize - 1};
+
+        const OrderId offset = id - base_;
+        const std::size_t page = offset >> PageBits;
+        if (id < base_ || page >= MaxPages) [[unlikely]] {
+            overflow_.emplace(id, handle);
+            return;
+        }
+
+        if (page >= directory_.size()) directory_.resize(page + 1, nullptr);
+        Page *&p = directory_[page];
+        if (!p) p = acquirePage();
+        p->handles[offset & (PageSize - 1)] = handle;
+        ++p->live;
+    }
+
+    OrderHandle extract(OrderId id) {
+        const OrderId offset = id - base_;
+        const std::size_t page = offset >> PageBits;
+        if (page < directory_.size()) [[likely]] {
+            if (Page *p = directory_[page]) {
+                OrderHandle &entry = p->handles[offset & (PageSize - 1)];
+                if (entry.valid()) [[likely]] {
+                    const OrderHandle handle = entry;
+                    entry = {};
+                    --size_;
+                    if (--p->live == 0) retirePage(page);
+                    return handle;
+                }
+            }
+        }
+        return extractOverflow(id);
+    }
+
+    void erase(OrderId id) { extract(id); }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    void reserve(std::size_t orders) { directory_.reserve(std::min(orders / PageSize + 1, MaxPages)); }
+
+    void clear() {
+        for (Page *p: directory_) {
+            if (!p) continue;
+            std::ranges::fill(p->handles, OrderHandle{});
+            p->live = 0;
+            freePages_.push_back(p);
+        }
+        directory_.clear();
+        overflow_.clear();
+        size_ = 0;
+    }
+
+    template<class F>
+    void forEach(F &&f) const {
+        for (std::size_t page = 0; page < directory_.size(); ++page) {
+            const Page *p = directory_[page];
+            if (!p) continue;
+            for (std::size_t i = 0; i < PageSize; ++i) {
+                if (p->handles[i].valid()) f(base_ + (page << PageBits) + i, p->handles[i]);
+            }
+        }
+        for (const auto &[id, handle]: overflow_) f(id, handle);
+    }
+
+    // Pages currently mapped by the directory, and pages waiting for reuse.
+    [[nodiscard]] std::size_t livePages() const {
+        return static_cast<std::size_t>(std::ranges::count_if(directory_, [](const Page *p) { return p != nullptr; }));
+    }
+
+    [[nodiscard]] std::size_t freePages() const { return freePages_.size(); }
+
+private:
+    struct Page {
+        OrderHandle handles[PageSize];
+        std::uint32_t live;
+    };
+
+    Page *acquirePage() {
+        if (!freePages_.empty()) {
+            Page *p = freePages_.back();
+            freePages_.pop_back();
+            return p;
+        }
+        return storage_.emplace_back(std::make_unique<Page>()).get();
+    }
+
+    // Every entry of a dead page is already invalid, so it is reused as is. The last directory
+    // entry is kept, as the next ids usually land on it.
+    void retirePage(std::size_t page) {
+        freePages_.push_back(directory_[page]);
+        directory_[page] = nullptr;
+
+        std::size_t dead = 0;
+        while (dead + 1 < directory_.size() && !directory_[dead]) ++dead;
+        if (dead == 0) return;
+        directory_.erase(directory_.begin(), directory_.begin() + static_cast<std::ptrdiff_t>(dead));
+        base_ += dead * PageSize;
+    }
+
+    [[nodiscard]] OrderHandle findOverflow(OrderId id) const {
+        if (overflow_.empty()) return {};
+        const auto it = overflow_.find(id);
+        return it == overflow_.end() ? OrderHandle{} : it->second;
+    }
+
+    OrderHandle extractOverflow(OrderId id) {
+        if (overflow_.empty()) return {};
+        const auto it = overflow_.find(id);
+        if (it == overflow_.end()) return {};
+        const OrderHandle handle = it->second;
+        overflow_.erase(it);
+        --size_;
+        return handle;
+    }
+
+    std::vector<Page *> directory_;
+    OrderId base_{0};
+    std::size_t size_{0};
+    std::vector<Page *> freePages_;
+    std::vector<std::unique_ptr<Page> > storage_;
+    std::unordered_map<OrderId, OrderHandle> overflow_;
+};
+
+#ifdef ORDERBOOK_DIRECT_ORDER_INDEX
+using OrderIndex = DirectOrderIndex;
+#else
+using OrderIndex = HashOrderIndex;
+#endif
+
+#endif //ORDERBOOK_ORDERINDEX_H
@@ -0,0 +1,140 @@
+#ifndef ORDERBOOK_ORDERLIST_H
+#define ORDERBOOK_ORDERLIST_H
+
+#include "OrderPool.h"
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// FIFO of orders at one price level, threaded through OrderPool slots.
+class OrderList {
+public:
+    template<class Pool, class Value>
+    class BasicIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Order;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        BasicIterator() = default;
+
+        BasicIterator(Pool *pool, OrderSlot slot) : pool_{pool}, slot_{slot} {
+        }
+
+        reference operator*() const { return (*pool_)[slot_]; }
+
+        pointer operator->() const { return &(*pool_)[slot_]; }
+
+        BasicIterator &operator++() {
+            slot_ = pool_->node(slot_).next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] OrderSlot slot() const { return slot_; }
+
+        friend bool operator==(const BasicIterator &a, const BasicIterator &b) { return a.slot_ == b.slot_; }
+
+    private:
+        Pool *pool_{};
+        OrderSlot slot_{INVALID_SLOT};
+    };
+
+    using iterator = BasicIterator<OrderPool, Order>;
+    using const_iterator = BasicIterator<const OrderPool, const Order>;
+
+    OrderList() = default;
+
+    explicit OrderList(OrderPool &pool) : pool_{&pool} {
+    }
+
+    void attach(OrderPool &pool) { pool_ = &pool; }
+
+    [[nodiscard]] bool empty() const { return head_ == INVALID_SLOT; }
+
+    [[nodiscard]] OrderSlot frontSlot() const { return head_; }
+
+    Order &front() {
+        assert(!empty());
+        return (*pool_)[head_];
+    }
+
+    [[nodiscard]] const Order &front() const {
+        assert(!empty());
+        return (*pool_)[head_];
+    }
+
+    OrderSlot push_back(const Order &order) {
+        const OrderSlot slot = pool_->allocate(order);
+        auto &node = pool_->node(slot);
+        node.prev = tail_;
+        node.next = INVALID_SLOT;
+
+        if (tail_ == INVALID_SLOT) head_ = slot;
+        else pool_->node(tail_).next = slot;
+        tail_ = slot;
+        return slot;
+    }
+
+    void erase(OrderSlot slot) {
+        const auto &node = pool_->node(slot);
+        const OrderSlot prev = node.prev;
+        const OrderSlot next = node.next;
+
+        if (prev == INVALID_SLOT) head_ = next;
+        else pool_->node(prev).next = next;
+
+        if (next == INVALID_SLOT) tail_ = prev;
+        else pool_->node(next).prev = prev;
+
+        pool_->release(slot);
+    }
+
+    // Hands each slot and order to f in FIFO order, then releases every node in one pass without relinking.
+    // Returns the number of orders released.
+    template<class F>
+    std::size_t releaseAll(F &&f) {
+        std::size_t released = 0;
+        for (OrderSlot slot = head_; slot != INVALID_SLOT; ++released) {
+            const OrderSlot next = pool_->node(slot).next;
+            f(slot, std::as_const((*pool_)[slot]));
+            pool_->release(slot);
+            slot = next;
+        }
+        head_ = tail_ = INVALID_SLOT;
+        return released;
+    }
+
+    // Forgets every node without releasing it; only valid alongside OrderPool::reset().
+    void reset() { head_ = tail_ = INVALID_SLOT; }
+
+    void pop_front() {
+        assert(!empty());
+        erase(head_);
+    }
+
+    iterator begin() { return {pool_, head_}; }
+
+    iterator end() { return {pool_, INVALID_SLOT}; }
+
+    [[nodiscard]] const_iterator begin() const { return {pool_, head_}; }
+
+    [[nodiscard]] const_iterator end() const { return {pool_, INVALID_SLOT}; }
+
+private:
+    OrderPool *pool_{};
+    OrderSlot head_{INVALID_SLOT};
+    OrderSlot tail_{INVALID_SLOT};
+};
+
+using Orders = OrderList;
+
+#endif //ORDERBOOK_ORDERLIST_H
@@ -32,8 +32,8 @@ public:
         return quantity_;
     }
 
-    [[nodiscard]] Order toOrder(OrderType type) const {
-        return {id_, type, side_, price_, quantity_};
+    [[nodiscard]] Order toOrder(OrderType type, OwnerId owner = Constants::NO_OWNER) const {
+        return {id_, type, side_, price_, quantity_, owner};
     }
 
 private:
@@ -0,0 +1,131 @@
+#ifndef ORDERBOOK_ORDERPOOL_H
+#define ORDERBOOK_ORDERPOOL_H
+
+#include "Order.h"
+#include "shared/MappedRegion.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using OrderSlot = std::uint32_t;
+
+constexpr inline OrderSlot INVALID_SLOT = std::numeric_limits<OrderSlot>::max();
+
+// An Order plus its FIFO links. The links are 32-bit pool slots rather than pointers,
+// so two nodes share a cache line instead of one std::list node (and its malloc header).
+struct OrderNode {
+    Order order;
+    OrderSlot prev{INVALID_SLOT};
+    OrderSlot next{INVALID_SLOT};
+};
+
+static_assert(sizeof(OrderNode) == 32, "OrderNode should stay half a cache line");
+
+// Names one resting order without its id: the pool slot plus the slot's generation at the time.
+// Every release of the slot bumps the generation, so a handle to a gone order never matches
+// whatever reuses its slot.
+struct OrderHandle {
+    OrderSlot slot{INVALID_SLOT};
+    std::uint32_t generation{0};
+
+    [[nodiscard]] bool valid() const { return slot != INVALID_SLOT; }
+
+    friend bool operator==(const OrderHandle &, const OrderHandle &) = default;
+};
+
+// Page-allocated slab of OrderNodes with an intrusive free list. Pages never move,
+// so references to live orders stay valid while the pool grows. The first
+// MemoryOptions::reservedOrders nodes come from one mapping; later pages from the heap.
+class OrderPool {
+public:
+    OrderPool() = default;
+
+    explicit OrderPool(const MemoryOptions &memory)
+        : reserved_{pagesFor(memory.reservedOrders) * PAGE_SIZE * sizeof(OrderNode), memory} {
+        auto *nodes = static_cast<OrderNode *>(reserved_.data());
+        for (std::size_t page = 0; page < pagesFor(memory.reservedOrders); ++page) {
+            pages_.push_back(nodes + page * PAGE_SIZE);
+        }
+    }
+
+    OrderPool(const OrderPool &) = delete;
+
+    OrderPool &operator=(const OrderPool &) = delete;
+
+    OrderSlot allocate(const Order &order) {
+        OrderSlot slot;
+        if (freeHead_ != INVALID_SLOT) {
+            slot = freeHead_;
+            freeHead_ = node(slot).next;
+        } else {
+            if (used_ == pages_.size() * PAGE_SIZE) addPage();
+            if (used_ == generations_.size()) generations_.push_back(0);
+            slot = used_++;
+        }
+        std::construct_at(&node(slot), order);
+        return slot;
+    }
+
+    void release(OrderSlot slot) {
+        ++generations_[slot];
+        node(slot).next = freeHead_;
+        freeHead_ = slot;
+    }
+
+    // Invalidates every slot at once. Pages stay mapped, so a reused pool is already warm.
+    void reset() {
+        for (OrderSlot slot = 0; slot < used_; ++slot) ++generations_[slot];
+        used_ = 0;
+        freeHead_ = INVALID_SLOT;
+    }
+
+    [[nodiscard]] OrderHandle handleOf(OrderSlot slot) const { return {slot, generations_[slot]}; }
+
+    // True while the order the handle was taken from still occupies its slot.
+    [[nodiscard]] bool live(OrderHandle handle) const {
+        return handle.slot < used_ && generations_[handle.slot] == handle.generation;
+    }
+
+    [[nodiscard]] OrderNode &node(OrderSlot slot) {
+        assert(slot < used_);
+        return pages_[slot >> PAGE_BITS][slot & PAGE_MASK];
+    }
+
+    [[nodiscard]] const OrderNode &node(OrderSlot slot) const {
+        assert(slot < used_);
+        return pages_[slot >> PAGE_BITS][slot & PAGE_MASK];
+    }
+
+    [[nodiscard]] Order &operator[](OrderSlot slot) { return node(slot).order; }
+
+    [[nodiscard]] const Order &operator[](OrderSlot slot) const { return node(slot).order; }
+
+private:
+    static constexpr std::size_t PAGE_BITS = 12;
+    static constexpr std::size_t PAGE_SIZE = std::size_t{1} << PAGE_BITS;
+    static constexpr std::size_t PAGE_MASK = PAGE_SIZE - 1;
+
+    static constexpr std::size_t pagesFor(std::size_t nodes) { return (nodes + PAGE_SIZE - 1) / PAGE_SIZE; }
+
+    struct PageDeleter {
+        void operator()(OrderNode *page) const { std::allocator<OrderNode>{}.deallocate(page, PAGE_SIZE); }
+    };
+
+    void addPage() {
+        // Nodes are constructed on allocate(); Order is trivially destructible, so pages are never walked.
+        pages_.push_back(heapPages_.emplace_back(std::allocator<OrderNode>{}.allocate(PAGE_SIZE)).get());
+    }
+
+    MappedRegion reserved_;
+    std::vector<OrderNode *> pages_;
+    std::vector<std::unique_ptr<OrderNode[], PageDeleter> > heapPages_;
+    // Indexed by slot; kept out of OrderNode so two nodes still share a cache line.
+    std::vector<std::uint32_t> generations_;
+    OrderSlot used_{0};
+    OrderSlot freeHead_{INVALID_SLOT};
+};
+
+#endif //ORDERBOOK_ORDERPOOL_H
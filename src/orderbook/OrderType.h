@@ -5,7 +5,9 @@
 #ifndef ORDERBOOK_ORDERTYPE_H
 #define ORDERBOOK_ORDERTYPE_H
 
-enum class OrderType {
+#include <cstdint>
+
+enum class OrderType : std::uint8_t {
     GoodTillCancel,
     FillAndKill,
     Market,
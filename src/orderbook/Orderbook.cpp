@@ -4,6 +4,11 @@
 
 #include "Orderbook.h"
 
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
 template<int N, Side S>
 void Orderbook::pruneStaleFillOrKill(LevelArray<N, S> &levels) {
     auto best = levels.getBestOrders();
@@ -13,7 +18,7 @@ void Orderbook::pruneStaleFillOrKill(LevelArray<N, S> &levels) {
     auto &orders = ordersRef.get();
 
     switch (auto &order = orders.front(); order.getType()) {
-        case OrderType::FillAndKill: cancelOrderInternal(order.getId());
+        case OrderType::FillAndKill: cancelOrderInternal(order.getId(), ExecutionReport::Type::Killed);
             break;
 
         case OrderType::FillOrKill: throw std::logic_error("There was a stale FOK order, should never be possible.");
@@ -35,12 +40,16 @@ void Orderbook::pruneStaleGoodForNow() {
     OrderIds stale;
     {
         std::scoped_lock lock{orderMutex_};
-        for (const auto &[id, ordersIterator]: orders_) {
-            if (ordersIterator->getType() == OrderType::GoodForDay)
+        orders_.forEach([&](OrderId id, OrderHandle handle) {
+            if (pool_.live(handle) && pool_[handle.slot].getType() == OrderType::GoodForDay)
                 stale.push_back(id);
+        });
+        // Parked GFD stops expire with the day too; cancelOrders falls through to cancelStop for them.
+        for (const auto &[id, stop]: stops_) {
+            if (pool_[stop.slot].getType() == OrderType::GoodForDay) stale.push_back(id);
         }
     }
-    cancelOrders(stale);
+    cancelOrders(stale, ExecutionReport::Type::Expired);
 }
 
 bool Orderbook::waitTillPruneTime() {
@@ -76,7 +85,8 @@ bool Orderbook::waitTillPruneTime() {
     return false;
 }
 
-Orderbook::Orderbook(bool startPruneThread) {
+Orderbook::Orderbook(bool startPruneThread, const MemoryOptions &memory)
+    : pool_{memory}, bids_{pool_, memory}, asks_{pool_, memory} {
     if (startPruneThread) {
         gfdPruneThread_ = std::thread([this] {
             pruneStaleGoodForDay();
@@ -108,38 +118,175 @@ Orderbook::~Orderbook() {
 
 [[nodiscard]] std::size_t Orderbook::size() const {
     std::scoped_lock _{orderMutex_};
-    return orders_.size();
+    return orders_.size() - staleIndexEntries_;
+}
+
+std::uint64_t Orderbook::bookHash() const {
+    std::scoped_lock _{orderMutex_};
+    if (!hashing_) [[unlikely]] {
+        bookHash_ = computeBookHash();
+        hashing_ = true;
+    }
+    return bookHash_;
+}
+
+std::uint64_t Orderbook::recomputeBookHash() const {
+    std::scoped_lock _{orderMutex_};
+    return computeBookHash();
+}
+
+// Caller holds orderMutex_.
+std::uint64_t Orderbook::computeBookHash() const {
+    std::uint64_t hash = 0;
+    const auto hashLevel = [&](Price, const Orders &orders) {
+        std::optional<OrderId> ahead;
+        for (const Order &order: orders) {
+            hash ^= BookHash::term(order, ahead);
+            ahead = order.getId();
+        }
+    };
+    bids_.forEachLevelBestToWorst(hashLevel);
+    asks_.forEachLevelBestToWorst(hashLevel);
+    return hash;
+}
+
+std::size_t Orderbook::stopCount() const {
+    std::scoped_lock _{orderMutex_};
+    return stops_.size();
+}
+
+std::optional<Price> Orderbook::getLastTradePrice() const {
+    std::scoped_lock _{orderMutex_};
+    return lastTradePrice_;
 }
 
 std::optional<double> Orderbook::getMidPrice() const {
     const auto bestBid = bids_.getBestPrice();
     const auto bestAsk = asks_.getBestPrice();
     if (!bestBid && !bestAsk) return std::nullopt;
-    return (bestBid.value_or(bestAsk.value()) / 2.0 + bestAsk.value_or(bestBid.value()) / 2.0);
+    if (!bestBid) return *bestAsk;
+    if (!bestAsk) return *bestBid;
+    return *bestBid / 2.0 + *bestAsk / 2.0;
 }
 
-void Orderbook::addOrder(const Order &order) {
+OrderHandle Orderbook::addOrder(const Order &order) {
+    return submitInternal(order, nullptr);
+}
+
+void Orderbook::cancelOrder(OrderId orderId) {
+#ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
+    cancelCount_++;
+    timer_.start();
+#endif
+    std::scoped_lock _{orderMutex_};
+    replicate({.id = orderId, .type = ReplicationEvent::Type::Cancel});
+    cancelOrderInternal(orderId);
+    publishLevelUpdates();
+#ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
+    cancelTotalTime_ += timer_.elapsed();
+#endif
+}
+
+SubmitResult Orderbook::submit(const Order &order) {
+    SubmitResult result;
+    result.handle = submitInternal(order, &result);
+    return result;
+}
+
+OrderHandle Orderbook::submitInternal(const Order &order, SubmitResult *capture) {
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     addCount_++;
     timer_.start();
 #endif
     std::scoped_lock _{orderMutex_};
-    addOrderInternal(order);
+    replicate(replicationOf(ReplicationEvent::Type::Add, order));
+    submitCapture_ = capture;
+    submitId_ = order.getId();
+    const OrderHandle handle = addOrderInternal(order);
+    releaseTriggeredStops();
+    publishLevelUpdates();
+    submitCapture_ = nullptr;
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     addTotalTime_ += timer_.elapsed();
 #endif
+    return pool_.live(handle) ? handle : OrderHandle{};
 }
 
-void Orderbook::cancelOrder(OrderId orderId) {
+bool Orderbook::cancelOrder(OrderHandle handle) {
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     cancelCount_++;
     timer_.start();
 #endif
     std::scoped_lock _{orderMutex_};
-    cancelOrderInternal(orderId);
+    if (!pool_.live(handle)) return false;
+    replicate({.id = pool_[handle.slot].getId(), .type = ReplicationEvent::Type::Cancel});
+
+    removeOrder(handle.slot, ExecutionReport::Type::Cancelled);
+    leaveStaleIndexEntry();
+    publishLevelUpdates();
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     cancelTotalTime_ += timer_.elapsed();
 #endif
+    return true;
+}
+
+std::optional<Quantity> Orderbook::reduceOrder(OrderId orderId, Quantity quantity) {
+    std::scoped_lock _{orderMutex_};
+    replicate({.id = orderId, .quantity = quantity, .type = ReplicationEvent::Type::Reduce});
+    const OrderHandle handle = findResting(orderId);
+    if (!handle.valid()) return std::nullopt;
+
+    if (quantity >= pool_[handle.slot].getRemainingQuantity()) {
+        cancelOrderInternal(orderId);
+        publishLevelUpdates();
+        return 0;
+    }
+    shrinkOrder(handle.slot, quantity);
+    publishLevelUpdates();
+    return pool_[handle.slot].getRemainingQuantity();
+}
+
+std::optional<Quantity> Orderbook::reduceOrder(OrderHandle handle, Quantity quantity) {
+    std::scoped_lock _{orderMutex_};
+    if (!pool_.live(handle)) return std::nullopt;
+    replicate({.id = pool_[handle.slot].getId(), .quantity = quantity, .type = ReplicationEvent::Type::Reduce});
+
+    if (quantity >= pool_[handle.slot].getRemainingQuantity()) {
+        removeOrder(handle.slot, ExecutionReport::Type::Cancelled);
+        leaveStaleIndexEntry();
+        publishLevelUpdates();
+        return 0;
+    }
+    shrinkOrder(handle.slot, quantity);
+    publishLevelUpdates();
+    return pool_[handle.slot].getRemainingQuantity();
+}
+
+OrderHandle Orderbook::modifyOrder(OrderHandle handle, Price price, Quantity quantity) {
+#ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
+    modifyCount_++;
+    timer_.start();
+#endif
+    std::scoped_lock _{orderMutex_};
+    if (!pool_.live(handle)) return {};
+#ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
+    modifyWentThroughCount_++;
+#endif
+    const Order existing = pool_[handle.slot];
+    const OrderModify orderModify{existing.getId(), existing.getSide(), price, quantity};
+    replicate({
+        .id = orderModify.getId(), .quantity = quantity, .price = price, .type = ReplicationEvent::Type::Modify,
+        .side = orderModify.getSide()
+    });
+    removeOrder(handle.slot, ExecutionReport::Type::Replaced);
+    leaveStaleIndexEntry();
+    const OrderHandle replacement = addOrderInternal(orderModify.toOrder(existing.getType(), existing.getOwner()));
+    releaseTriggeredStops();
+    publishLevelUpdates();
+#ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
+    modifyTotalTime_ += timer_.elapsed();
+#endif
+    return pool_.live(replacement) ? replacement : OrderHandle{};
 }
 
 void Orderbook::modifyOrder(OrderModify orderModify) {
@@ -148,57 +295,305 @@ void Orderbook::modifyOrder(OrderModify orderModify) {
     timer_.start();
 #endif
     std::scoped_lock _{orderMutex_};
-    const auto ordersIterator = orders_.find(orderModify.getId());
-    if (ordersIterator == orders_.end()) return;
+    replicate({
+        .id = orderModify.getId(), .quantity = orderModify.getQuantity(), .price = orderModify.getPrice(),
+        .type = ReplicationEvent::Type::Modify, .side = orderModify.getSide()
+    });
+    const OrderHandle handle = findResting(orderModify.getId());
+    if (!handle.valid()) return;
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     modifyWentThroughCount_++;
 #endif
-    const OrderType type{ordersIterator->second->getType()};
-    cancelOrderInternal(orderModify.getId());
-    addOrderInternal(orderModify.toOrder(type));
+    const Order &existing = pool_[handle.slot];
+    const OrderType type{existing.getType()};
+    const OwnerId owner{existing.getOwner()};
+    cancelOrderInternal(orderModify.getId(), ExecutionReport::Type::Replaced);
+    addOrderInternal(orderModify.toOrder(type, owner));
+    releaseTriggeredStops();
+    publishLevelUpdates();
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
     modifyTotalTime_ += timer_.elapsed();
 #endif
 }
 
+std::size_t Orderbook::cancelSide(Side side) {
+    return cancelPriceRange(side, std::numeric_limits<Price>::min(), std::numeric_limits<Price>::max());
+}
+
+std::size_t Orderbook::cancelPriceRange(Side side, Price low, Price high) {
+    std::scoped_lock _{orderMutex_};
+    replicate({.price = low, .stopPrice = high, .type = ReplicationEvent::Type::CancelRange, .side = side});
+
+    // Whole levels go, front to back, so each order's predecessor is the previous one at its price.
+    std::optional<std::pair<Price, OrderId> > previous;
+    const auto onCancelled = [this, side, &previous](OrderSlot slot, const Order &order) {
+        if (hashing_) {
+            const bool samePrice = previous && previous->first == order.getPrice();
+            bookHash_ ^= BookHash::term(order, samePrice ? std::optional{previous->second} : std::nullopt);
+            previous.emplace(order.getPrice(), order.getId());
+        }
+        orders_.erase(order.getId());
+        if (order.getOwner() != Constants::NO_OWNER) owners_.unlink(order.getOwner(), slot);
+        report(ExecutionReport::Type::Cancelled, order);
+        markLevelDirty(side, order.getPrice());
+    };
+    const std::size_t cancelled = side == Side::Buy
+                                      ? bids_.clearLevels(low, high, onCancelled)
+                                      : asks_.clearLevels(low, high, onCancelled);
+    publishLevelUpdates();
+    return cancelled;
+}
+
+std::size_t Orderbook::cancelAllForOwner(OwnerId owner) {
+    std::scoped_lock _{orderMutex_};
+    replicate({.owner = owner, .type = ReplicationEvent::Type::CancelOwner});
+
+    std::size_t cancelled = 0;
+    for (OrderSlot slot = owners_.first(owner); slot != INVALID_SLOT; ++cancelled) {
+        const OrderSlot next = owners_.next(slot);
+        orders_.erase(pool_[slot].getId());
+        removeOrder(slot, ExecutionReport::Type::Cancelled);
+        slot = next;
+    }
+
+    for (OrderSlot slot = stopOwners_.first(owner); slot != INVALID_SLOT; ++cancelled) {
+        const OrderSlot next = stopOwners_.next(slot);
+        cancelStop(pool_[slot].getId(), ExecutionReport::Type::Cancelled);
+        slot = next;
+    }
+    publishLevelUpdates();
+    return cancelled;
+}
+
+std::size_t Orderbook::ownerOrderCount(OwnerId owner) const {
+    std::scoped_lock _{orderMutex_};
+    return owners_.count(owner);
+}
+
+void Orderbook::reset() {
+    std::scoped_lock _{orderMutex_};
+    replicate({.type = ReplicationEvent::Type::Reset});
+
+    bids_.reset();
+    asks_.reset();
+    pool_.reset();
+    owners_.reset();
+    if (buyStops_) buyStops_->reset();
+    if (sellStops_) sellStops_->reset();
+    stops_.erase(stops_.begin(), stops_.end());
+    stopOwners_.reset();
+    triggeredStops_.clear();
+    lastTradePrice_.reset();
+    auction_ = false;
+    orders_.clear();
+    staleIndexEntries_ = 0;
+    bookHash_ = 0;
+    trades_.clear();
+    dirtyLevels_.clear();
+    if (quoteSlot_) {
+        rescanBids_ = rescanAsks_ = true;
+        publishQuote();
+        quoteSlot_ = nullptr;
+    }
+
+    l2Feed_.reset();
+    l2Sequence_ = 0;
+    conflator_.reset();
+    executionFeed_.reset();
+    executionSequence_ = 0;
+    depthImage_.reset();
+    depthSnapshot_.store(nullptr, std::memory_order_release);
+}
+
+void Orderbook::addStopOrder(const Order &order, Price stopPrice) {
+    using enum ExecutionReport::Reason;
+    std::scoped_lock _{orderMutex_};
+    replicate(replicationOf(ReplicationEvent::Type::AddStop, order, stopPrice));
+
+    if (order.getRemainingQuantity() == 0) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, ZeroQuantity);
+        return;
+    }
+    if (findResting(order.getId()).valid() || stops_.contains(order.getId())) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, DuplicateId);
+        return;
+    }
+    if (!BuyStops::contains(stopPrice)) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, PriceOutOfRange);
+        return;
+    }
+
+    OrderSlot slot;
+    if (order.getSide() == Side::Buy) {
+        if (!buyStops_) buyStops_ = std::make_unique<BuyStops>(pool_);
+        slot = buyStops_->getOrders(stopPrice)->get().push_back(order);
+        buyStops_->onOrderAdded(stopPrice);
+    } else {
+        if (!sellStops_) sellStops_ = std::make_unique<SellStops>(pool_);
+        slot = sellStops_->getOrders(stopPrice)->get().push_back(order);
+        sellStops_->onOrderAdded(stopPrice);
+    }
+    stops_.emplace(order.getId(), ParkedStop{slot, stopPrice});
+    if (order.getOwner() != Constants::NO_OWNER) stopOwners_.link(order.getOwner(), slot);
+    report(ExecutionReport::Type::Accepted, order);
+
+    // Fires at once if the last trade has already crossed the stop.
+    releaseTriggeredStops();
+    publishLevelUpdates();
+}
+
+void Orderbook::releaseTriggeredStops() {
+    if (stops_.empty()) return;
+
+    const auto onTriggered = [this](OrderSlot slot, const Order &order) {
+        stops_.erase(order.getId());
+        if (order.getOwner() != Constants::NO_OWNER) stopOwners_.unlink(order.getOwner(), slot);
+        triggeredStops_.push_back(order);
+    };
+
+    // Released orders can trade and move the last price, firing further stops: those are appended
+    // and submitted in the same loop rather than recursively.
+    std::size_t next = 0;
+    while (true) {
+        if (lastTradePrice_ && !stops_.empty()) {
+            if (buyStops_) buyStops_->clearLevels(std::numeric_limits<Price>::min(), *lastTradePrice_, onTriggered);
+            if (sellStops_) sellStops_->clearLevels(*lastTradePrice_, std::numeric_limits<Price>::max(), onTriggered);
+        }
+        if (next == triggeredStops_.size()) break;
+
+        const Order order = triggeredStops_[next++];
+        report(ExecutionReport::Type::Triggered, order);
+        addOrderInternal(order);
+    }
+    triggeredStops_.clear();
+}
+
+void Orderbook::cancelStop(OrderId orderId, ExecutionReport::Type reportAs) {
+    const auto it = stops_.find(orderId);
+    if (it == stops_.end()) return;
+
+    const auto [slot, stopPrice] = it->second;
+    stops_.erase(it);
+    report(reportAs, pool_[slot]);
+    if (pool_[slot].getOwner() != Constants::NO_OWNER) stopOwners_.unlink(pool_[slot].getOwner(), slot);
+
+    if (pool_[slot].getSide() == Side::Buy) {
+        buyStops_->getOrders(stopPrice)->get().erase(slot);
+        buyStops_->onOrderRemoved(stopPrice);
+    } else {
+        sellStops_->getOrders(stopPrice)->get().erase(slot);
+        sellStops_->onOrderRemoved(stopPrice);
+    }
+}
+
 // ===== Internal cancel / add helpers =====
 
-void Orderbook::cancelOrders(const OrderIds &orderIds) {
+void Orderbook::cancelOrders(const OrderIds &orderIds, ExecutionReport::Type reportAs) {
     std::scoped_lock _{orderMutex_};
 
+    const auto type = reportAs == ExecutionReport::Type::Expired ? ReplicationEvent::Type::Expire
+                                                                  : ReplicationEvent::Type::Cancel;
     for (const OrderId id: orderIds) {
-        cancelOrderInternal(id);
+        replicate({.id = id, .type = type});
+        cancelOrderInternal(id, reportAs);
     }
+    publishLevelUpdates();
+}
+
+void Orderbook::cancelOrderInternal(OrderId orderId, ExecutionReport::Type reportAs) {
+    const OrderHandle handle = orders_.extract(orderId);
+    if (!handle.valid() || !pool_.live(handle)) [[unlikely]] {
+        if (handle.valid()) --staleIndexEntries_;
+        if (!stops_.empty()) cancelStop(orderId, reportAs);
+        return;
+    }
+
+    removeOrder(handle.slot, reportAs);
+}
+
+OrderHandle Orderbook::findResting(OrderId orderId) {
+    const OrderHandle handle = orders_.find(orderId);
+    if (!handle.valid() || pool_.live(handle)) [[likely]] return handle;
+
+    orders_.erase(orderId);
+    --staleIndexEntries_;
+    return {};
+}
+
+void Orderbook::leaveStaleIndexEntry() {
+    if (++staleIndexEntries_ > orders_.size() / 3 + 1'024) dropStaleIndexEntries();
+}
+
+std::optional<OrderId> Orderbook::aheadOf(OrderSlot slot) const {
+    const OrderSlot prev = pool_.node(slot).prev;
+    if (prev == INVALID_SLOT) return std::nullopt;
+    return pool_[prev].getId();
+}
+
+// Caller checks hashing_.
+void Orderbook::rehashBehind(OrderSlot slot) {
+    const OrderSlot behind = pool_.node(slot).next;
+    if (behind == INVALID_SLOT) return;
+    bookHash_ ^= hashTerm(behind) ^ BookHash::term(pool_[behind], aheadOf(slot));
 }
 
-void Orderbook::cancelOrderInternal(OrderId orderId) {
-    auto it = orders_.find(orderId);
-    if (it == orders_.end()) [[unlikely]] return;
+void Orderbook::dropStaleIndexEntries() {
+    staleIds_.clear();
+    orders_.forEach([this](OrderId id, OrderHandle handle) {
+        if (!pool_.live(handle)) staleIds_.push_back(id);
+    });
+    for (const OrderId id: staleIds_) orders_.erase(id);
+    staleIndexEntries_ = 0;
+}
 
-    const auto listIt = it->second;
+void Orderbook::removeOrder(OrderSlot slot, ExecutionReport::Type reportAs) {
+    const Order &order = pool_[slot];
 
-    onOrderCanceled(*listIt);
+    onOrderCanceled(order);
+    report(reportAs, order);
+    if (order.getOwner() != Constants::NO_OWNER) owners_.unlink(order.getOwner(), slot);
+    if (hashing_) {
+        bookHash_ ^= hashTerm(slot);
+        rehashBehind(slot);
+    }
 
-    const Price price = listIt->getPrice();
-    const Side side = listIt->getSide();
+    const Price price = order.getPrice();
+    const Side side = order.getSide();
 
     if (side == Side::Buy) {
         auto ordersOpt = bids_.getOrders(price);
         assert(ordersOpt && "Cancel: price must be in range");
-        ordersOpt->get().erase(listIt);
+        ordersOpt->get().erase(slot);
         bids_.onOrderRemoved(price);
     } else {
         auto ordersOpt = asks_.getOrders(price);
         assert(ordersOpt && "Cancel: price must be in range");
-        ordersOpt->get().erase(listIt);
+        ordersOpt->get().erase(slot);
         asks_.onOrderRemoved(price);
     }
-    orders_.erase(it);
 }
 
-void Orderbook::addOrderInternal(Order order) {
-    if (order.getRemainingQuantity() == 0 || orders_.contains(order.getId())) [[unlikely]] {
-        return;
+void Orderbook::shrinkOrder(OrderSlot slot, Quantity quantity) {
+    Order &order = pool_[slot];
+    // The order behind chains on this one's id only, so its term is unaffected.
+    if (hashing_) bookHash_ ^= hashTerm(slot);
+    order.fill(quantity);
+    if (hashing_) bookHash_ ^= hashTerm(slot);
+
+    updateLevelData(order.getPrice(), quantity, LevelData::Action::Match, order.getSide());
+    report(ExecutionReport::Type::Replaced, order);
+}
+
+OrderHandle Orderbook::addOrderInternal(Order order) {
+    using enum ExecutionReport::Reason;
+
+    if (order.getRemainingQuantity() == 0) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, ZeroQuantity);
+        return {};
+    }
+    if (findResting(order.getId()).valid() || (!stops_.empty() && stops_.contains(order.getId()))) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, DuplicateId);
+        return {};
     }
 
     const Side side = order.getSide();
@@ -206,41 +601,65 @@ void Orderbook::addOrderInternal(Order order) {
     if (order.getType() == OrderType::Market) {
         if (side == Side::Sell) {
             const auto worstBidPrice = bids_.getWorstPrice();
-            if (!worstBidPrice) [[unlikely]] return;
+            if (!worstBidPrice) [[unlikely]] {
+                report(ExecutionReport::Type::Killed, order, NoLiquidity);
+                return {};
+            }
             order.toFillAndKill(*worstBidPrice);
         } else if (side == Side::Buy) {
             const auto worstAskPrice = asks_.getWorstPrice();
-            if (!worstAskPrice) [[unlikely]] return;
+            if (!worstAskPrice) [[unlikely]] {
+                report(ExecutionReport::Type::Killed, order, NoLiquidity);
+                return {};
+            }
             order.toFillAndKill(*worstAskPrice);
-        } else return;
+        } else return {};
     }
 
     const Price price = order.getPrice();
 
+    if (!decltype(bids_)::contains(price)) [[unlikely]] {
+        report(ExecutionReport::Type::Rejected, order, PriceOutOfRange);
+        return {};
+    }
+
+    // Market orders were turned into FAKs above; nothing immediate can execute before the uncross.
+    if (auction_ && (order.getType() == OrderType::FillAndKill || order.getType() == OrderType::FillOrKill))
+        [[unlikely]] {
+        report(ExecutionReport::Type::Killed, order, AuctionInProgress);
+        return {};
+    }
+
     if (order.getType() == OrderType::FillAndKill && !canMatch(side, price)) {
-        return;
+        report(ExecutionReport::Type::Killed, order, NotMarketable);
+        return {};
     }
 
     if (order.getType() == OrderType::FillOrKill && !canFullyFill(side, price, order.getRemainingQuantity())) {
-        return;
+        report(ExecutionReport::Type::Killed, order, NotFullyFillable);
+        return {};
     }
 
     const auto ordersOpt = (side == Side::Buy) ? bids_.getOrders(price) : asks_.getOrders(price);
-    if (!ordersOpt) [[unlikely]] return;
+    if (!ordersOpt) [[unlikely]] return {};
 
     Orders &orders = ordersOpt->get();
 
-    orders.push_back(order);
-    auto iterator = std::prev(orders.end());
+    const OrderSlot slot = orders.push_back(order);
+    if (hashing_) bookHash_ ^= hashTerm(slot);
 
-    orders_.emplace(order.getId(), iterator);
+    const OrderHandle handle = pool_.handleOf(slot);
+    orders_.insert(order.getId(), handle);
+    if (order.getOwner() != Constants::NO_OWNER) owners_.link(order.getOwner(), slot);
 
     onOrderAdded(order);
+    report(ExecutionReport::Type::Accepted, order);
 
     if (side == Side::Buy) bids_.onOrderAdded(price);
     else asks_.onOrderAdded(price);
 
-    matchOrders();
+    if (!auction_) matchOrders(side);
+    return handle;
 }
 
 // ===== Matching / eligibility =====
@@ -267,8 +686,42 @@ bool Orderbook::canFullyFill(Side side, Price price, Quantity quantity) const {
     }
 }
 
+Quantity Orderbook::quantityThrough(Side side, Price price) const {
+    std::scoped_lock _{orderMutex_};
+    return side == Side::Buy ? bids_.quantityThrough(price) : asks_.quantityThrough(price);
+}
 
-void Orderbook::matchOrders() {
+std::optional<Price> Orderbook::priceReaching(Side side, Quantity quantity) const {
+    std::scoped_lock _{orderMutex_};
+    return side == Side::Buy ? bids_.priceReaching(quantity) : asks_.priceReaching(quantity);
+}
+
+LevelInfos Orderbook::getDepth(Side side, std::size_t levels) const {
+    LevelInfos depth;
+    depth.reserve(std::min<std::size_t>(levels, 64));
+    const auto collect = [&](Price price, const LevelData &data) { depth.push_back({price, data.quantity}); };
+
+    std::scoped_lock _{orderMutex_};
+    if (side == Side::Buy) bids_.forEachTopLevel(levels, collect);
+    else asks_.forEachTopLevel(levels, collect);
+    return depth;
+}
+
+SweepEstimate Orderbook::estimateSweep(Side side, Quantity quantity) const {
+    std::scoped_lock _{orderMutex_};
+    return side == Side::Buy ? asks_.estimateSweep(quantity) : bids_.estimateSweep(quantity);
+}
+
+void Orderbook::estimateSweeps(Side side, std::span<const Quantity> sizes, std::span<SweepEstimate> out) const {
+    if (out.size() < sizes.size()) throw std::invalid_argument("estimateSweeps needs an estimate slot per size");
+    if (!std::ranges::is_sorted(sizes)) throw std::invalid_argument("estimateSweeps needs sizes in ascending order");
+
+    std::scoped_lock _{orderMutex_};
+    if (side == Side::Buy) asks_.estimateSweeps(sizes, out);
+    else bids_.estimateSweeps(sizes, out);
+}
+
+void Orderbook::matchOrders(Side aggressor) {
     while (true) {
         auto bestBid = bids_.getBestOrders();
         auto bestAsk = asks_.getBestOrders();
@@ -282,67 +735,285 @@ void Orderbook::matchOrders() {
         if (highestBid < lowestAsk) break;
 
         while (!askOrders.empty() && !bidOrders.empty()) {
-            auto &bidOrder{bidOrders.front()};
-            auto &askOrder{askOrders.front()};
+            // The aggressor just crossed the spread, so it trades at the resting order's price.
+            lastTradePrice_ = aggressor == Side::Buy ? lowestAsk : highestBid;
+            fillFronts(bidOrders, askOrders,
+                       std::min(bidOrders.front().getRemainingQuantity(), askOrders.front().getRemainingQuantity()));
+        }
+    }
+    pruneStaleFillOrKill(bids_);
+    pruneStaleFillOrKill(asks_);
+}
+
+void Orderbook::fillFronts(Orders &bidOrders, Orders &askOrders, Quantity quantity, std::optional<Price> clearingPrice) {
+    auto &bidOrder{bidOrders.front()};
+    auto &askOrder{askOrders.front()};
+
+    // Both are at the front of their level, so nothing is queued ahead of them.
+    if (hashing_) bookHash_ ^= BookHash::term(bidOrder, std::nullopt) ^ BookHash::term(askOrder, std::nullopt);
+    bidOrder.fill(quantity);
+    askOrder.fill(quantity);
+
+    const Price askOrderPrice = askOrder.getPrice();
+    const Price bidOrderPrice = bidOrder.getPrice();
+    trades_.emplace_back(
+        bidOrder.getId(), askOrder.getId(),
+        clearingPrice.value_or(bidOrderPrice), clearingPrice.value_or(askOrderPrice),
+        quantity);
+
+    const bool bidFilled = bidOrder.isFilled();
+    const bool askFilled = askOrder.isFilled();
+
+    onOrderMatched(bidOrderPrice, quantity, bidFilled, Side::Buy);
+    onOrderMatched(askOrderPrice, quantity, askFilled, Side::Sell);
+
+    using enum ExecutionReport::Type;
+    report(bidFilled ? Filled : PartiallyFilled, bidOrder, ExecutionReport::Reason::None, quantity, askOrder.getId());
+    report(askFilled ? Filled : PartiallyFilled, askOrder, ExecutionReport::Reason::None, quantity, bidOrder.getId());
+
+    if (hashing_) {
+        if (bidFilled) rehashBehind(bidOrders.frontSlot());
+        else bookHash_ ^= BookHash::term(bidOrder, std::nullopt);
+        if (askFilled) rehashBehind(askOrders.frontSlot());
+        else bookHash_ ^= BookHash::term(askOrder, std::nullopt);
+    }
 
-            const Quantity tradedQuantity = std::min(bidOrder.getRemainingQuantity(), askOrder.getRemainingQuantity());
+    if (bidFilled) {
+        orders_.erase(bidOrder.getId());
+        if (bidOrder.getOwner() != Constants::NO_OWNER)
+            owners_.unlink(bidOrder.getOwner(), bidOrders.frontSlot());
+        bidOrders.pop_front();
+        if (bidOrders.empty()) bids_.onOrderRemoved(bidOrderPrice);
+    }
+    if (askFilled) {
+        orders_.erase(askOrder.getId());
+        if (askOrder.getOwner() != Constants::NO_OWNER)
+            owners_.unlink(askOrder.getOwner(), askOrders.frontSlot());
+        askOrders.pop_front();
+        if (askOrders.empty()) asks_.onOrderRemoved(askOrderPrice);
+    }
+}
 
-            bidOrder.fill(tradedQuantity);
-            askOrder.fill(tradedQuantity);
+// ===== Call auction =====
 
-            const Price askOrderPrice = askOrder.getPrice();
-            const Price bidOrderPrice = bidOrder.getPrice();
-            trades_.emplace_back(
-                bidOrder.getId(), askOrder.getId(),
-                bidOrderPrice, askOrderPrice,
-                tradedQuantity);
+void Orderbook::openAuction() {
+    std::scoped_lock _{orderMutex_};
+    replicate({.type = ReplicationEvent::Type::OpenAuction});
+    auction_ = true;
+}
 
-            const bool bidFilled = bidOrder.isFilled();
-            const bool askFilled = askOrder.isFilled();
+bool Orderbook::inAuction() const {
+    std::scoped_lock _{orderMutex_};
+    return auction_;
+}
 
-            onOrderMatched(bidOrderPrice, tradedQuantity, bidFilled, Side::Buy);
-            onOrderMatched(askOrderPrice, tradedQuantity, askFilled, Side::Sell);
+std::optional<AuctionResult> Orderbook::uncross() {
+    std::scoped_lock _{orderMutex_};
+    replicate({.type = ReplicationEvent::Type::Uncross});
+    auction_ = false;
+
+    const auto result = auctionClearing_.compute(bids_, asks_, lastTradePrice_);
+    if (!result) return std::nullopt;
+
+    // One allocation pass in price-time priority. Volume-maximizing prices leave no residual
+    // cross, so the book is uncrossed when the volume runs out.
+    for (Quantity remaining = result->volume; remaining > 0;) {
+        auto &bidOrders = bids_.getBestOrders()->second.get();
+        auto &askOrders = asks_.getBestOrders()->second.get();
+        const Quantity quantity = std::min({
+            bidOrders.front().getRemainingQuantity(), askOrders.front().getRemainingQuantity(), remaining
+        });
+        fillFronts(bidOrders, askOrders, quantity, result->price);
+        remaining -= quantity;
+    }
+    lastTradePrice_ = result->price;
 
-            if (bidFilled) {
-                orders_.erase(bidOrder.getId());
-                bidOrders.pop_front();
-                if (bidOrders.empty()) bids_.onOrderRemoved(bidOrderPrice);
-            }
-            if (askFilled) {
-                orders_.erase(askOrder.getId());
-                askOrders.pop_front();
-                if (askOrders.empty()) asks_.onOrderRemoved(askOrderPrice);
-            }
+    releaseTriggeredStops();
+    publishLevelUpdates();
+    return result;
+}
+
+std::optional<AuctionResult> Orderbook::indicativeUncross() const {
+    std::scoped_lock _{orderMutex_};
+    return auctionClearing_.compute(bids_, asks_, lastTradePrice_);
+}
+
+L2Feed &Orderbook::subscribeL2(std::size_t capacity) {
+    std::scoped_lock _{orderMutex_};
+    if (l2Feed_) return *l2Feed_;
+
+    l2Feed_ = std::make_unique<L2Feed>(capacity);
+    markAllLevelsDirty();
+    publishLevelUpdates();
+    return *l2Feed_;
+}
+
+ConflatingConsumer Orderbook::subscribeConflated() {
+    std::scoped_lock _{orderMutex_};
+    if (!conflator_) {
+        conflator_ = std::make_unique<ConflatingPublisher>();
+        markAllLevelsDirty();
+        publishLevelUpdates();
+    }
+    return ConflatingConsumer{*conflator_};
+}
+
+void Orderbook::markAllLevelsDirty() {
+    bids_.forEachLevelBestToWorst([&](Price price, const Orders &) {
+        dirtyLevels_.emplace_back(Side::Buy, price);
+    });
+    asks_.forEachLevelBestToWorst([&](Price price, const Orders &) {
+        dirtyLevels_.emplace_back(Side::Sell, price);
+    });
+}
+
+void Orderbook::publishMarketData(const MarketDataSegment &segment, std::size_t symbol) {
+    QuoteSlot &slot = segment.slot(symbol);
+    std::scoped_lock _{orderMutex_};
+    quoteSlot_ = &slot;
+    rescanBids_ = rescanAsks_ = true;
+    publishQuote();
+}
+
+void Orderbook::updateQuote(Side side, Price price, const LevelData &data) {
+    const bool buy = side == Side::Buy;
+    bool &rescan = buy ? rescanBids_ : rescanAsks_;
+    if (rescan) return;
+
+    QuoteLevel *levels = buy ? quote_.bids : quote_.asks;
+    std::uint32_t &quoted = buy ? quote_.bidLevels : quote_.askLevels;
+    const auto better = [buy](Price a, Price b) { return buy ? a > b : a < b; };
+    std::uint32_t i = 0;
+    while (i < quoted && better(levels[i].price, price)) ++i;
+
+    // The quote mirrors the book's best levels, and while quoted < Depth it holds the whole side,
+    // so only removing a level from a full quote needs a scan to find the one that moves up.
+    if (i < quoted && levels[i].price == price) {
+        if (data.count != 0) {
+            levels[i] = {price, static_cast<std::uint32_t>(data.count), data.quantity};
+        } else if (quoted == Quote::Depth) {
+            rescan = true;
+        } else {
+            std::copy(levels + i + 1, levels + quoted, levels + i);
+            levels[--quoted] = {};
         }
+    } else if (data.count != 0 && i < Quote::Depth) {
+        if (quoted < Quote::Depth) ++quoted;
+        std::copy_backward(levels + i, levels + quoted - 1, levels + quoted);
+        levels[i] = {price, static_cast<std::uint32_t>(data.count), data.quantity};
+    } else {
+        return;
     }
-    pruneStaleFillOrKill(bids_);
-    pruneStaleFillOrKill(asks_);
+    quoteChanged_ = true;
+}
+
+void Orderbook::publishQuote() {
+    const auto collect = [](QuoteLevel *levels, std::uint32_t &count) {
+        std::fill_n(levels, Quote::Depth, QuoteLevel{});
+        count = 0;
+        return [levels, &count](Price price, const LevelData &data) {
+            levels[count++] = {price, static_cast<std::uint32_t>(data.count), data.quantity};
+        };
+    };
+    if (rescanBids_) bids_.forEachTopLevel(Quote::Depth, collect(quote_.bids, quote_.bidLevels));
+    if (rescanAsks_) asks_.forEachTopLevel(Quote::Depth, collect(quote_.asks, quote_.askLevels));
+    quoteChanged_ = rescanBids_ = rescanAsks_ = false;
+
+    quote_.publishedNs = sharedClockNs();
+    quoteSlot_->store(quote_);
+}
+
+ReplicationPublisher &Orderbook::replicateTo(const std::string &name, std::size_t capacity) {
+    std::scoped_lock _{orderMutex_};
+    if (orders_.size() != staleIndexEntries_ || !stops_.empty() || lastTradePrice_ || auction_) {
+        throw std::logic_error("Replication must start from a fresh book");
+    }
+    replication_ = std::make_unique<ReplicationPublisher>(name, capacity);
+    return *replication_;
+}
+
+ExecutionFeed &Orderbook::subscribeExecutions(std::size_t capacity) {
+    std::scoped_lock _{orderMutex_};
+    if (!executionFeed_) executionFeed_ = std::make_unique<ExecutionFeed>(capacity);
+    return *executionFeed_;
+}
+
+void Orderbook::report(ExecutionReport::Type type, const Order &order, ExecutionReport::Reason reason,
+                       Quantity lastQuantity, OrderId counterpartyId) {
+    if (submitCapture_ && order.getId() == submitId_) [[unlikely]] {
+        submitCapture_->last = type;
+        submitCapture_->reason = reason;
+        if (lastQuantity != 0) {
+            submitCapture_->filled += lastQuantity;
+            ++submitCapture_->fills;
+        }
+    }
+    if (!executionFeed_) return;
+    executionFeed_->publish({
+        ++executionSequence_, order.getId(), counterpartyId, lastQuantity, order.getRemainingQuantity(),
+        order.getPrice(), type, reason, order.getSide()
+    });
 }
 
 // ===== Read-only views =====
 
 [[nodiscard]] OrderbookLevelInfos Orderbook::getOrderInfos() const {
-    std::scoped_lock _{orderMutex_};
+    return getDepthSnapshot()->levels;
+}
 
-    LevelInfos levelInfosBids, levelInfosAsks;
+std::shared_ptr<const DepthSnapshot> Orderbook::getDepthSnapshot() const {
+    const Timer timer;
+    auto snapshot = depthSnapshot_.load(std::memory_order_acquire);
 
-    auto createLevelInfo = [](Price price, const Orders &orders) {
-        const Quantity total = std::accumulate(
-            orders.begin(), orders.end(), Quantity{0},
-            [](Quantity q, const Order &o) { return q + o.getRemainingQuantity(); }
-        );
-        return LevelInfo{price, total};
+    if (!snapshot || snapshot->version != depthVersion_.load(std::memory_order_acquire)) {
+        snapshotRequested_.store(true, std::memory_order_relaxed);
+
+        std::unique_lock lock{orderMutex_, std::try_to_lock};
+        if (!lock.owns_lock() && !snapshot) lock.lock();
+
+        if (lock.owns_lock()) {
+            if (!depthImage_) enableDepthImage();
+            snapshotRequested_.store(false, std::memory_order_relaxed);
+            publishDepthSnapshot();
+            snapshot = depthSnapshot_.load(std::memory_order_relaxed);
+        } else {
+            staleSnapshotReads_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    snapshotReads_.record(static_cast<std::uint64_t>(timer.elapsed() * 1e9));
+    return snapshot;
+}
+
+SnapshotMetrics Orderbook::getSnapshotMetrics() const {
+    return {
+        snapshotReads_.count(), staleSnapshotReads_.load(std::memory_order_relaxed),
+        snapshotReads_.averageNs(), snapshotReads_.maxNs(),
+        snapshotPublishes_.count(), snapshotPublishes_.averageNs(), snapshotPublishes_.maxNs()
     };
+}
 
-    bids_.forEachLevelBestToWorst([&](Price price, const Orders &orders) {
-        levelInfosBids.push_back(createLevelInfo(price, orders));
+void Orderbook::enableDepthImage() const {
+    depthImage_ = std::make_unique<DepthImage>();
+    bids_.forEachLevelBestToWorst([&](Price price, const Orders &) {
+        depthImage_->apply(Side::Buy, price, bids_.getLevelData(price));
     });
-
-    asks_.forEachLevelBestToWorst([&](Price price, const Orders &orders) {
-        levelInfosAsks.push_back(createLevelInfo(price, orders));
+    asks_.forEachLevelBestToWorst([&](Price price, const Orders &) {
+        depthImage_->apply(Side::Sell, price, asks_.getLevelData(price));
     });
+}
 
-    return {levelInfosBids, levelInfosAsks};
+// Caller holds orderMutex_.
+void Orderbook::publishDepthSnapshot() const {
+    const Timer timer;
+    const std::uint64_t version = depthVersion_.load(std::memory_order_relaxed);
+    const auto current = depthSnapshot_.load(std::memory_order_relaxed);
+    if (current && current->version == version) return;
+
+    depthSnapshot_.store(std::make_shared<const DepthSnapshot>(
+                             version, OrderbookLevelInfos{depthImage_->bids(), depthImage_->asks()}),
+                         std::memory_order_release);
+    snapshotPublishes_.record(static_cast<std::uint64_t>(timer.elapsed() * 1e9));
 }
 
 
@@ -365,16 +1036,39 @@ void Orderbook::onOrderCanceled(const Order &order) {
 }
 
 void Orderbook::updateLevelData(Price price, Quantity quantity, LevelData::Action action, Side side) {
-    auto dataOpt = (side == Side::Buy) ? bids_.getLevelData(price) : asks_.getLevelData(price);
-    assert(dataOpt && "updateLevelData: price must be in range");
-    auto &[remainingQuantity, count] = dataOpt->get();
+    if (side == Side::Buy) bids_.updateLevelData(price, quantity, action);
+    else asks_.updateLevelData(price, quantity, action);
 
-    if (action == LevelData::Action::Add) count++;
-    else if (action == LevelData::Action::Remove) count--;
+    markLevelDirty(side, price);
+}
 
-    if (action == LevelData::Action::Remove || action == LevelData::Action::Match) {
-        remainingQuantity -= quantity;
-    } else {
-        remainingQuantity += quantity;
+void Orderbook::markLevelDirty(Side side, Price price) {
+    if (tracksLevels() && (dirtyLevels_.empty() || dirtyLevels_.back() != std::pair{side, price})) {
+        dirtyLevels_.emplace_back(side, price);
     }
 }
+
+void Orderbook::publishLevelUpdates() {
+    if (dirtyLevels_.empty()) return;
+
+    // A sweep touches each level in a run, so repeats are rare; a batch cancel can revisit levels.
+    if (dirtyLevels_.size() > 2) {
+        std::ranges::sort(dirtyLevels_);
+        const auto [first, last] = std::ranges::unique(dirtyLevels_);
+        dirtyLevels_.erase(first, last);
+    }
+
+    for (const auto &[side, price]: dirtyLevels_) {
+        const LevelData data = (side == Side::Buy) ? bids_.getLevelData(price) : asks_.getLevelData(price);
+        if (l2Feed_) l2Feed_->publish({++l2Sequence_, data.quantity, data.count, price, side});
+        if (conflator_) conflator_->publish(side, price, data);
+        if (depthImage_) depthImage_->apply(side, price, data);
+        if (quoteSlot_) updateQuote(side, price, data);
+    }
+    dirtyLevels_.clear();
+    if (quoteChanged_) publishQuote();
+
+    if (!depthImage_) return;
+    depthVersion_.fetch_add(1, std::memory_order_release);
+    if (snapshotRequested_.exchange(false, std::memory_order_relaxed)) publishDepthSnapshot();
+}
@@ -7,12 +7,28 @@
 
 #include "Usings.h"
 #include "Order.h"
+#include "OrderPool.h"
+#include "OrderIndex.h"
+#include "OwnerIndex.h"
 #include "Trade.h"
 #include "OrderModify.h"
 #include "OrderbookLevelInfos.h"
 #include "LevelArray.h"
+#include "Feed.h"
+#include "ConflatingPublisher.h"
+#include "DepthSnapshot.h"
+#include "Auction.h"
+#include "SweepEstimate.h"
+#include "SubmitResult.h"
+#include "BookHash.h"
+#include "Replication.h"
+#include "MarketData.h"
+#include <atomic>
+#include <memory>
+#include <condition_variable>
 #include <thread>
 #include <mutex>
+#include <span>
 
 #ifdef ORDERBOOK_ENABLE_INSTRUMENTATION
 
@@ -33,10 +49,73 @@ private:
     Timer timer_{};
 #endif
 
+    OrderPool pool_;
     LevelArray<Constants::LEVELARRAY_SIZE, Side::Buy> bids_;
     LevelArray<Constants::LEVELARRAY_SIZE, Side::Sell> asks_;
-    std::unordered_map<OrderId, OrdersIterator> orders_;
+    // Handle-based cancels leave their id's entry behind instead of looking it up; such entries fail
+    // OrderPool::live() and are dropped by the next id lookup that meets them, or all at once
+    // by dropStaleIndexEntries() once they are a third of the index.
+    OrderIndex orders_;
+    std::size_t staleIndexEntries_{0};
+    std::vector<OrderId> staleIds_;
+    OwnerIndex owners_;
+    // See BookHash. Off until the first bookHash() call, which computes it from scratch; from then
+    // on every change to a resting order keeps it current, and reset() leaves it on.
+    mutable bool hashing_{false};
+    mutable std::uint64_t bookHash_{0};
     Trades trades_;
+    std::optional<Price> lastTradePrice_;
+
+    // Parked stops, keyed by stop price. A buy stop fires once the last trade rises to its price, so
+    // the next to fire is the lowest: the ask ladder's scan order. Sell stops mirror the bids.
+    using BuyStops = LevelArray<Constants::LEVELARRAY_SIZE, Side::Sell>;
+    using SellStops = LevelArray<Constants::LEVELARRAY_SIZE, Side::Buy>;
+
+    struct ParkedStop {
+        OrderSlot slot;
+        Price stopPrice;
+    };
+
+    std::unique_ptr<BuyStops> buyStops_;
+    std::unique_ptr<SellStops> sellStops_;
+    std::unordered_map<OrderId, ParkedStop> stops_;
+    // Parked stops by owner, for cancelAllForOwner; resting orders are in owners_.
+    OwnerIndex stopOwners_;
+    std::vector<Order> triggeredStops_;
+
+    bool auction_{false};
+    mutable AuctionClearing auctionClearing_;
+
+    std::unique_ptr<L2Feed> l2Feed_;
+    std::vector<std::pair<Side, Price> > dirtyLevels_;
+    std::uint64_t l2Sequence_{0};
+    std::unique_ptr<ConflatingPublisher> conflator_;
+
+    std::unique_ptr<ExecutionFeed> executionFeed_;
+    std::uint64_t executionSequence_{0};
+
+    std::unique_ptr<ReplicationPublisher> replication_;
+
+    // The shared memory slot this book publishes its quote to, and the quote being kept current.
+    // A side is rescanned only when a level enters or leaves its quoted depth.
+    QuoteSlot *quoteSlot_{nullptr};
+    Quote quote_{};
+    bool quoteChanged_{false};
+    bool rescanBids_{false};
+    bool rescanAsks_{false};
+
+    // Set for the duration of submit(); report() folds the submitted order's reports into it.
+    SubmitResult *submitCapture_{nullptr};
+    OrderId submitId_{0};
+
+    // Built on the first snapshot request; from then on kept current by publishLevelUpdates().
+    mutable std::unique_ptr<DepthImage> depthImage_;
+    std::atomic<std::uint64_t> depthVersion_{0};
+    mutable std::atomic<std::shared_ptr<const DepthSnapshot> > depthSnapshot_;
+    mutable std::atomic<bool> snapshotRequested_{false};
+    mutable LatencyStat snapshotReads_;
+    mutable LatencyStat snapshotPublishes_;
+    mutable std::atomic<std::uint64_t> staleSnapshotReads_{0};
 
     mutable std::mutex orderMutex_{};
     std::thread gfdPruneThread_;
@@ -44,6 +123,7 @@ private:
     std::condition_variable shutdownConditionVariable_{};
 
     friend class PruneTestHelper;
+    friend class SnapshotTestHelper;
 
     void onOrderMatched(Price price, Quantity quantity, bool fullMatch, Side side);
 
@@ -53,16 +133,65 @@ private:
 
     void updateLevelData(Price price, Quantity quantity, LevelData::Action action, Side side);
 
+    void publishLevelUpdates();
+
+    void markAllLevelsDirty();
+
+    void markLevelDirty(Side side, Price price);
+
+    [[nodiscard]] bool tracksLevels() const { return l2Feed_ || conflator_ || depthImage_ || quoteSlot_; }
+
+    void updateQuote(Side side, Price price, const LevelData &data);
+
+    void publishQuote();
+
+    void enableDepthImage() const;
+
+    void publishDepthSnapshot() const;
+
+    // Writes one input to the replication ring, if replicating. Caller holds orderMutex_.
+    void replicate(const ReplicationEvent &event) {
+        if (replication_) [[unlikely]] replication_->publish(event);
+    }
+
+    static ReplicationEvent replicationOf(ReplicationEvent::Type type, const Order &order, Price stopPrice = 0) {
+        return {
+            .id = order.getId(), .quantity = order.getRemainingQuantity(), .price = order.getPrice(),
+            .stopPrice = stopPrice, .owner = order.getOwner(), .type = type, .orderType = order.getType(),
+            .side = order.getSide()
+        };
+    }
+
+    void report(ExecutionReport::Type type, const Order &order,
+                ExecutionReport::Reason reason = ExecutionReport::Reason::None,
+                Quantity lastQuantity = 0, OrderId counterpartyId = 0);
+
     bool canMatch(Side side, Price price);
 
-    void matchOrders();
+    void matchOrders(Side aggressor);
+
+    // Trades the front bid against the front ask; at the clearing price during an uncross,
+    // otherwise each side records its own order's price.
+    void fillFronts(Orders &bidOrders, Orders &askOrders, Quantity quantity,
+                    std::optional<Price> clearingPrice = std::nullopt);
+
+    void releaseTriggeredStops();
 
-    void cancelOrders(const OrderIds &orderIds);
+    void cancelStop(OrderId orderId, ExecutionReport::Type reportAs);
+
+    void cancelOrders(const OrderIds &orderIds, ExecutionReport::Type reportAs);
 
     template<int N, Side S>
     void pruneStaleFillOrKill(LevelArray<N, S> &levels);
 
-    void cancelOrderInternal(OrderId orderId);
+    void cancelOrderInternal(OrderId orderId,
+                             ExecutionReport::Type reportAs = ExecutionReport::Type::Cancelled);
+
+    // Removes a resting order whose orders_ entry the caller has already erased or left stale.
+    void removeOrder(OrderSlot slot, ExecutionReport::Type reportAs);
+
+    // Takes quantity off a resting order without moving it; quantity is below its remainder.
+    void shrinkOrder(OrderSlot slot, Quantity quantity);
 
     void pruneStaleGoodForDay();
 
@@ -70,29 +199,175 @@ private:
 
     void pruneStaleGoodForNow();
 
-    void addOrderInternal(Order order);
+    // The live handle indexed under orderId, or an invalid one; drops a stale entry it meets.
+    OrderHandle findResting(OrderId orderId);
+
+    void leaveStaleIndexEntry();
+
+    // The order queued directly ahead of slot at its level, if any.
+    [[nodiscard]] std::optional<OrderId> aheadOf(OrderSlot slot) const;
+
+    [[nodiscard]] std::uint64_t hashTerm(OrderSlot slot) const { return BookHash::term(pool_[slot], aheadOf(slot)); }
+
+    [[nodiscard]] std::uint64_t computeBookHash() const;
+
+    // Moves the order behind slot up to slot's place in the hash; call before slot is unlinked.
+    void rehashBehind(OrderSlot slot);
+
+    void dropStaleIndexEntries();
+
+    // Returns the handle of the order's slot if it was inserted, whether or not it still rests.
+    OrderHandle addOrderInternal(Order order);
+
+    // The public add: addOrder() and submit(), which passes capture to collect the order's reports.
+    // Returns the handle if the order rests.
+    OrderHandle submitInternal(const Order &order, SubmitResult *capture);
 
 public:
-    explicit Orderbook(bool startPruneThread = true);
+    // memory controls how the level arrays and the reserved order nodes are mapped; see MemoryOptions.
+    explicit Orderbook(bool startPruneThread = true, const MemoryOptions &memory = {});
 
     ~Orderbook();
 
-    void addOrder(const Order &order);
+    // Returns a handle to the order if it rests in the book when the call returns, otherwise an
+    // invalid handle (rejected, killed or fully filled).
+    OrderHandle addOrder(const Order &order);
+
+    // addOrder() that also reports what happened to the order within the call: fills, whether it
+    // rests, and its last execution report (Filled, Killed, Rejected, ...).
+    SubmitResult submit(const Order &order);
+
+    // Parks order until the last trade reaches stopPrice (at or above it for a buy, at or below for a
+    // sell), then submits it: a Market order gives a stop, a limit order a stop-limit. Stops fired by
+    // one call's trades, including the trades of other fired stops, are released within that call.
+    void addStopOrder(const Order &order, Price stopPrice);
 
     void modifyOrder(OrderModify orderModify);
 
     void cancelOrder(OrderId orderId);
 
+    // Handle-based cancel and modify for co-located callers: the order is found from the handle's
+    // slot, with no id lookup. A stale handle (the order has since filled, been cancelled or been
+    // replaced) is detected by its generation and changes nothing: cancel returns false, modify
+    // an invalid handle. A modify keeps id, side, type and owner and returns the new order's handle.
+    bool cancelOrder(OrderHandle handle);
+
+    OrderHandle modifyOrder(OrderHandle handle, Price price, Quantity quantity);
+
+    // Lowers a resting order's quantity by quantity in place, keeping its place in the queue, as an
+    // exchange does for a partial cancel. Reducing by the whole remainder or more cancels it.
+    // Returns the quantity left (0 once cancelled), or nullopt if the order does not rest here.
+    std::optional<Quantity> reduceOrder(OrderId orderId, Quantity quantity);
+
+    std::optional<Quantity> reduceOrder(OrderHandle handle, Quantity quantity);
+
+    // Mass cancels for pulling quotes. They work level by level: each FIFO is released whole, its
+    // LevelData zeroed, and best/worst fixed once at the end. Return the number of orders cancelled.
+    std::size_t cancelSide(Side side);
+
+    std::size_t cancelPriceRange(Side side, Price low, Price high);
+
+    // Cancel-on-disconnect: walks the owner's intrusive lists of resting orders and parked stops,
+    // so the cost is proportional to that owner's orders. Returns the number cancelled.
+    std::size_t cancelAllForOwner(OwnerId owner);
+
+    [[nodiscard]] std::size_t ownerOrderCount(OwnerId owner) const;
+
+    // Call auction. While open, orders rest without matching, so the book may cross; FAK, FOK and
+    // Market orders are killed. uncross() executes everything at the single volume-maximizing price
+    // and returns to continuous matching. Returns nullopt (and still reopens) if nothing crosses.
+    void openAuction();
+
+    [[nodiscard]] bool inAuction() const;
+
+    std::optional<AuctionResult> uncross();
+
+    // The price, volume and surplus uncross() would produce now, without executing anything.
+    [[nodiscard]] std::optional<AuctionResult> indicativeUncross() const;
+
+    // Returns the book to its freshly constructed state in time proportional to the levels and
+    // orders used since construction or the last reset; storage stays allocated and warm.
+    // Subscriptions are dropped, so previously returned feeds and consumers must not be used.
+    // Replication carries on: the standby resets too.
+    void reset();
+
     std::optional<double> getMidPrice() const;
 
     [[nodiscard]] std::size_t size() const;
 
+    // 64-bit hash of every resting order's id, side, price, remaining quantity and queue position;
+    // see BookHash. Parked stops are not included, and an empty book hashes to 0. The first call
+    // walks the book; after that the hash is maintained in O(1) per add, fill and cancel, so
+    // replicas and engine variants can be compared continuously. Books never asked pay nothing.
+    [[nodiscard]] std::uint64_t bookHash() const;
+
+    // bookHash() recomputed from scratch by walking every level; O(resting orders).
+    [[nodiscard]] std::uint64_t recomputeBookHash() const;
+
+    [[nodiscard]] std::size_t stopCount() const;
+
+    [[nodiscard]] std::optional<Price> getLastTradePrice() const;
+
+    // Copy of the latest depth snapshot; see getDepthSnapshot().
     [[nodiscard]] OrderbookLevelInfos getOrderInfos() const;
 
+    // Full depth without waiting on the matcher. If the book is mid-call the previous snapshot is
+    // returned and a fresh one is published at the end of that call. The first call builds the
+    // depth image under the book lock.
+    [[nodiscard]] std::shared_ptr<const DepthSnapshot> getDepthSnapshot() const;
+
+    [[nodiscard]] SnapshotMetrics getSnapshotMetrics() const;
+
     [[nodiscard]] bool canFullyFill(Side side, Price price, Quantity quantity) const;
 
+    // Depth queries on one side of the book, answered from its contiguous level quantities and
+    // counts with the vector kernels in LevelKernels.
+
+    // Total quantity resting on side from its best price through price.
+    [[nodiscard]] Quantity quantityThrough(Side side, Price price) const;
+
+    // The price at which the cumulative quantity on side, best first, reaches quantity.
+    [[nodiscard]] std::optional<Price> priceReaching(Side side, Quantity quantity) const;
+
+    // Up to levels non-empty levels on side, best first.
+    [[nodiscard]] LevelInfos getDepth(Side side, std::size_t levels) const;
+
+    // Fill, cost and depth of an aggressive order of side for quantity against the current book,
+    // with no limit price. Walks the opposite side's levels from its best price, under the lock and
+    // without allocating.
+    [[nodiscard]] SweepEstimate estimateSweep(Side side, Quantity quantity) const;
+
+    // estimateSweep() for many sizes in one walk. sizes must be ascending; out[i] answers sizes[i].
+    // Throws std::invalid_argument for unsorted sizes or an out shorter than sizes.
+    void estimateSweeps(Side side, std::span<const Quantity> sizes, std::span<SweepEstimate> out) const;
+
+    // Starts the L2 delta stream (one consumer). The current depth is published first, so a
+    // fresh L2BookBuilder fed from the returned feed reconstructs the whole book.
+    L2Feed &subscribeL2(std::size_t capacity = Constants::L2_FEED_CAPACITY);
+
+    // Registers a conflating reader: it pulls the latest state of every level changed since its
+    // previous pull, at its own pace. The consumer must not outlive the book.
+    ConflatingConsumer subscribeConflated();
+
+    // Hot-standby replication: from now on every input the book executes (adds, cancels, modifies,
+    // mass cancels, GFD expiries, auction calls, resets) is written, in execution order, to a new
+    // POSIX shared memory ring called name, for a StandbyReplica to apply. The standby starts from a
+    // fresh book, so this throws std::logic_error unless the book is empty, has no last trade price
+    // (stops trigger on it) and is not in an auction; reset() first to replicate a used book.
+    ReplicationPublisher &replicateTo(const std::string &name,
+                                      std::size_t capacity = Constants::REPLICATION_RING_CAPACITY);
+
+    // Publishes the best MARKET_DATA_DEPTH levels of each side to symbol's slot of segment, now and
+    // at the end of every call that changes them. One book per slot, and the segment must outlive
+    // the book. reset() publishes the empty book and detaches. Throws std::out_of_range.
+    void publishMarketData(const MarketDataSegment &segment, std::size_t symbol);
+
+    // Starts the per-order execution report stream (one consumer): accepts, fills, cancels,
+    // GFD expiries, FAK/FOK kills and rejected adds.
+    ExecutionFeed &subscribeExecutions(std::size_t capacity = Constants::EXECUTION_FEED_CAPACITY);
+
     friend std::ostream &operator<<(std::ostream &os, const Orderbook &ob) {
-        return os << ob.getOrderInfos();
+        return os << ob.getDepthSnapshot()->levels;
     }
 
     const Trades &getTrades() const {
@@ -0,0 +1,72 @@
+#ifndef ORDERBOOK_OWNERINDEX_H
+#define ORDERBOOK_OWNERINDEX_H
+
+#include "OrderPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Intrusive per-owner lists over OrderPool slots. The links sit in a side table indexed by slot
+// instead of in OrderNode, so the matcher keeps two nodes per cache line; an owned order costs
+// 8 bytes here and an unowned one nothing.
+class OwnerIndex {
+public:
+    void link(OwnerId owner, OrderSlot slot) {
+        if (slot >= links_.size()) links_.resize(slot + 1);
+        if (owner >= owners_.size()) owners_.resize(owner + 1);
+
+        auto &list = owners_[owner];
+        links_[slot] = {INVALID_SLOT, list.head};
+        if (list.head != INVALID_SLOT) links_[list.head].prev = slot;
+        list.head = slot;
+        ++list.count;
+    }
+
+    void unlink(OwnerId owner, OrderSlot slot) {
+        auto &list = owners_[owner];
+        const auto [prev, next] = links_[slot];
+        if (prev == INVALID_SLOT) list.head = next;
+        else links_[prev].next = next;
+        if (next != INVALID_SLOT) links_[next].prev = prev;
+        --list.count;
+    }
+
+    [[nodiscard]] OrderSlot first(OwnerId owner) const {
+        return owner < owners_.size() ? owners_[owner].head : INVALID_SLOT;
+    }
+
+    [[nodiscard]] OrderSlot next(OrderSlot slot) const { return links_[slot].next; }
+
+    [[nodiscard]] std::size_t count(OwnerId owner) const {
+        return owner < owners_.size() ? owners_[owner].count : 0;
+    }
+
+    // Both tables keep their capacity.
+    void reset() {
+        links_.clear();
+        owners_.clear();
+    }
+
+    [[nodiscard]] std::size_t bytes() const {
+        return links_.capacity() * sizeof(Links) + owners_.capacity() * sizeof(OwnerList);
+    }
+
+    static constexpr std::size_t BytesPerOwnedOrder = 2 * sizeof(OrderSlot);
+
+private:
+    struct Links {
+        OrderSlot prev{INVALID_SLOT};
+        OrderSlot next{INVALID_SLOT};
+    };
+
+    struct OwnerList {
+        OrderSlot head{INVALID_SLOT};
+        std::uint32_t count{0};
+    };
+
+    std::vector<Links> links_;
+    std::vector<OwnerList> owners_;
+};
+
+#endif //ORDERBOOK_OWNERINDEX_H
@@ -0,0 +1,27 @@
+#include "Replication.h"
+
+#include <bit>
+#include <memory>
+
+ReplicationPublisher::ReplicationPublisher(const std::string &name, std::size_t capacity)
+    : capacity_{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)} {
+    memory_ = SharedMemory::create(name, ReplicationRingHeader::bytesFor(capacity_));
+    header_ = std::construct_at(static_cast<ReplicationRingHeader *>(memory_.data()));
+    header_->magic = ReplicationRingHeader::Magic;
+    header_->version = ReplicationRingHeader::Version;
+    header_->eventSize = sizeof(ReplicationEvent);
+    header_->capacity = capacity_;
+    events_ = header_->events();
+}
+
+ReplicationPublisher::~ReplicationPublisher() {
+    if (!overrun_) header_->state.store(ReplicationRingHeader::Closed, std::memory_order_release);
+}
+
+ReplicationLag ReplicationPublisher::lag() const {
+    const std::uint64_t applied = header_->applied.load(std::memory_order_acquire);
+    if (applied == published_) return {0, 0};
+    // Unapplied slots are never overwritten, so the oldest one is still intact.
+    const std::uint64_t oldest = events_[applied & (capacity_ - 1)].publishedNs;
+    return {published_ - applied, sharedClockNs() - oldest};
+}
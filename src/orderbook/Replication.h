@@ -0,0 +1,141 @@
+#ifndef ORDERBOOK_REPLICATION_H
+#define ORDERBOOK_REPLICATION_H
+
+#include "Usings.h"
+#include "Side.h"
+#include "OrderType.h"
+#include "shared/SharedMemory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// One input to the primary book, in the order the book executed it. A standby that applies the
+// same events to an empty book reaches the same state: matching is deterministic given its inputs.
+struct ReplicationEvent {
+    enum class Type : std::uint8_t {
+        Add,
+        AddStop,
+        Cancel,
+        Modify,
+        // A GFD order expired by the primary's close-of-day prune.
+        Expire,
+        CancelRange,
+        CancelOwner,
+        OpenAuction,
+        Uncross,
+        Reset,
+        Reduce
+    };
+
+    // 1-based and gap free.
+    std::uint64_t sequence{};
+    // The primary's steady clock when the event was written; CLOCK_MONOTONIC, so comparable
+    // across processes on the same host.
+    std::uint64_t publishedNs{};
+    OrderId id{};
+    Quantity quantity{};
+    // CancelRange covers price through stopPrice.
+    Price price{};
+    Price stopPrice{};
+    OwnerId owner{};
+    Type type{};
+    OrderType orderType{};
+    Side side{};
+};
+
+static_assert(std::is_trivially_copyable_v<ReplicationEvent>);
+
+struct ReplicationLag {
+    // Events published but not yet applied, and the age of the oldest of them (0 when caught up).
+    std::uint64_t events;
+    std::uint64_t nanoseconds;
+};
+
+// Layout of the shared memory object: this header, then capacity ReplicationEvents starting at
+// EventsOffset. published and applied are the ring's tail and head; each side writes only its own.
+struct ReplicationRingHeader {
+    static constexpr std::uint64_t Magic = 0x4f42'5245'504c'4943; // "OBREPLIC"
+    static constexpr std::uint32_t Version = 2;
+    static constexpr std::size_t EventsOffset = 256;
+
+    enum State : std::uint32_t {
+        Live,
+        // The standby fell a whole ring behind; the primary stopped publishing.
+        Overrun,
+        // The primary detached cleanly (book destroyed or replication stopped).
+        Closed
+    };
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t eventSize;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> published;
+    std::atomic<std::uint32_t> state;
+    alignas(64) std::atomic<std::uint64_t> applied;
+
+    [[nodiscard]] ReplicationEvent *events() {
+        return reinterpret_cast<ReplicationEvent *>(reinterpret_cast<std::byte *>(this) + EventsOffset);
+    }
+
+    static std::size_t bytesFor(std::size_t capacity) { return EventsOffset + capacity * sizeof(ReplicationEvent); }
+};
+
+static_assert(sizeof(ReplicationRingHeader) <= ReplicationRingHeader::EventsOffset);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "the ring's counters are shared between processes, so they must be address-free");
+
+// Primary side of the ring, owned by the book (Orderbook::replicateTo) and written under its lock.
+// Publishing never waits: if the standby is a full ring behind, the ring is marked Overrun and
+// replication stops, since a standby that missed events can only be rebuilt by a full replay.
+class ReplicationPublisher {
+public:
+    // Creates the shared memory object name; capacity is rounded up to a power of two.
+    ReplicationPublisher(const std::string &name, std::size_t capacity);
+
+    // Marks the ring Closed, so the standby knows the primary went away on purpose.
+    ~ReplicationPublisher();
+
+    ReplicationPublisher(const ReplicationPublisher &) = delete;
+
+    ReplicationPublisher &operator=(const ReplicationPublisher &) = delete;
+
+    void publish(ReplicationEvent event) {
+        if (overrun_) [[unlikely]] return;
+        if (published_ - cachedApplied_ == capacity_) {
+            cachedApplied_ = header_->applied.load(std::memory_order_acquire);
+            if (published_ - cachedApplied_ == capacity_) [[unlikely]] {
+                overrun_ = true;
+                header_->state.store(ReplicationRingHeader::Overrun, std::memory_order_release);
+                return;
+            }
+        }
+        event.sequence = published_ + 1;
+        event.publishedNs = sharedClockNs();
+        events_[published_ & (capacity_ - 1)] = event;
+        header_->published.store(++published_, std::memory_order_release);
+    }
+
+    [[nodiscard]] std::uint64_t published() const { return published_; }
+
+    [[nodiscard]] bool overrun() const { return overrun_; }
+
+    // How far the standby is behind, as seen from the primary.
+    [[nodiscard]] ReplicationLag lag() const;
+
+    [[nodiscard]] const std::string &name() const { return memory_.name(); }
+
+private:
+    SharedMemory memory_;
+    ReplicationRingHeader *header_;
+    ReplicationEvent *events_;
+    std::uint64_t capacity_;
+    std::uint64_t published_{0};
+    std::uint64_t cachedApplied_{0};
+    bool overrun_{false};
+};
+
+#endif //ORDERBOOK_REPLICATION_H
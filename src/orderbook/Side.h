@@ -5,7 +5,9 @@
 #ifndef ORDERBOOK_SIDE_H
 #define ORDERBOOK_SIDE_H
 
-enum class Side {
+#include <cstdint>
+
+enum class Side : std::uint8_t {
     Buy,
     Sell
 };
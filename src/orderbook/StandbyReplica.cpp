@@ -0,0 +1,101 @@
+#include "StandbyReplica.h"
+
+#include <stdexcept>
+#include <thread>
+
+void applyReplicationEvent(Orderbook &book, const ReplicationEvent &event) {
+    using enum ReplicationEvent::Type;
+    const Order order{event.id, event.orderType, event.side, event.price, event.quantity, event.owner};
+    switch (event.type) {
+        case Add: book.addOrder(order);
+            break;
+        case AddStop: book.addStopOrder(order, event.stopPrice);
+            break;
+        case Cancel:
+        case Expire: book.cancelOrder(event.id);
+            break;
+        case Modify: book.modifyOrder({event.id, event.side, event.price, event.quantity});
+            break;
+        case CancelRange: book.cancelPriceRange(event.side, event.price, event.stopPrice);
+            break;
+        case CancelOwner: book.cancelAllForOwner(event.owner);
+            break;
+        case OpenAuction: book.openAuction();
+            break;
+        case Uncross: book.uncross();
+            break;
+        case Reset: book.reset();
+            break;
+        case Reduce: book.reduceOrder(event.id, event.quantity);
+            break;
+    }
+}
+
+StandbyReplica::StandbyReplica(const std::string &name, const MemoryOptions &memory)
+    : memory_{SharedMemory::open(name)}, book_{false, memory} {
+    if (memory_.size() < ReplicationRingHeader::EventsOffset) {
+        throw std::runtime_error("Not a replication ring: " + name);
+    }
+    header_ = static_cast<ReplicationRingHeader *>(memory_.data());
+    if (header_->magic != ReplicationRingHeader::Magic || header_->version != ReplicationRingHeader::Version ||
+        header_->eventSize != sizeof(ReplicationEvent) ||
+        memory_.size() < ReplicationRingHeader::bytesFor(header_->capacity)) {
+        throw std::runtime_error("Not a replication ring: " + name);
+    }
+    events_ = header_->events();
+    mask_ = header_->capacity - 1;
+    applied_ = header_->applied.load(std::memory_order_acquire);
+    if (applied_ != 0) throw std::runtime_error("Replication ring already has a standby: " + name);
+}
+
+std::size_t StandbyReplica::poll() {
+    if (promoted_) return 0;
+    const std::uint64_t published = header_->published.load(std::memory_order_acquire);
+    if (published == applied_) return 0;
+
+    for (std::uint64_t i = applied_; i != published; ++i) {
+        const ReplicationEvent &event = events_[i & mask_];
+        applyReplicationEvent(book_, event);
+        applyLatency_.record(sharedClockNs() - event.publishedNs);
+    }
+    const auto count = static_cast<std::size_t>(published - applied_);
+    applied_ = published;
+    header_->applied.store(applied_, std::memory_order_release);
+    return count;
+}
+
+void StandbyReplica::run(const std::atomic<bool> &stop) {
+    while (!stop.load(std::memory_order_relaxed)) {
+        if (poll() != 0) continue;
+        if (state() != ReplicationRingHeader::Live) {
+            poll();
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+ReplicationLag StandbyReplica::lag() const {
+    const std::uint64_t published = header_->published.load(std::memory_order_acquire);
+    if (published == applied_) return {0, 0};
+    return {published - applied_, sharedClockNs() - events_[applied_ & mask_].publishedNs};
+}
+
+ReplicationRingHeader::State StandbyReplica::state() const {
+    return static_cast<ReplicationRingHeader::State>(header_->state.load(std::memory_order_acquire));
+}
+
+bool StandbyReplica::overrun() const {
+    return state() == ReplicationRingHeader::Overrun;
+}
+
+bool StandbyReplica::primaryClosed() const {
+    return state() == ReplicationRingHeader::Closed;
+}
+
+Orderbook &StandbyReplica::promote() {
+    if (overrun()) throw std::runtime_error("Standby was overrun and is stale: " + memory_.name());
+    poll();
+    promoted_ = true;
+    return book_;
+}
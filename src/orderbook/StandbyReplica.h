@@ -0,0 +1,72 @@
+#ifndef ORDERBOOK_STANDBYREPLICA_H
+#define ORDERBOOK_STANDBYREPLICA_H
+
+#include "Orderbook.h"
+#include "Replication.h"
+#include "shared/SharedMemory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hot standby for a primary book in another process (or thread) on the same host. It maps the
+// primary's replication ring and applies each event to its own book, keeping it in lockstep.
+// Failing over is promote(): apply whatever is left in the ring and take over the book, which
+// costs the remaining events rather than a replay of the day.
+class StandbyReplica {
+public:
+    // Opens the ring the primary created with Orderbook::replicateTo(name). Throws
+    // std::system_error if it does not exist, std::runtime_error if it is not a replication ring.
+    explicit StandbyReplica(const std::string &name, const MemoryOptions &memory = {});
+
+    StandbyReplica(const StandbyReplica &) = delete;
+
+    StandbyReplica &operator=(const StandbyReplica &) = delete;
+
+    // Applies every event published so far and returns how many there were.
+    std::size_t poll();
+
+    // Polls until stop is set or the primary detaches, yielding when there is nothing to apply.
+    void run(const std::atomic<bool> &stop);
+
+    // How far this replica is behind the primary.
+    [[nodiscard]] ReplicationLag lag() const;
+
+    [[nodiscard]] std::uint64_t applied() const { return applied_; }
+
+    // Publish-to-apply latency of every event applied so far.
+    [[nodiscard]] const LatencyStat &applyLatency() const { return applyLatency_; }
+
+    // The primary stopped replicating because this replica fell a whole ring behind; the book is
+    // stale and must be rebuilt by replay.
+    [[nodiscard]] bool overrun() const;
+
+    [[nodiscard]] bool primaryClosed() const;
+
+    // Applies the rest of the ring, detaches from it and hands over the book; later polls do
+    // nothing. Throws std::runtime_error if the replica was overrun.
+    Orderbook &promote();
+
+    [[nodiscard]] bool promoted() const { return promoted_; }
+
+    // The replica's book. Read it freely; changing it before promote() breaks the lockstep.
+    [[nodiscard]] Orderbook &book() { return book_; }
+
+private:
+    [[nodiscard]] ReplicationRingHeader::State state() const;
+
+    SharedMemory memory_;
+    ReplicationRingHeader *header_;
+    const ReplicationEvent *events_;
+    std::uint64_t mask_;
+    std::uint64_t applied_{0};
+    bool promoted_{false};
+    LatencyStat applyLatency_;
+    Orderbook book_;
+};
+
+// Applies one replicated input to book through its public API.
+void applyReplicationEvent(Orderbook &book, const ReplicationEvent &event);
+
+#endif //ORDERBOOK_STANDBYREPLICA_H
@@ -0,0 +1,22 @@
+#ifndef ORDERBOOK_SUBMITRESULT_H
+#define ORDERBOOK_SUBMITRESULT_H
+
+#include "ExecutionReport.h"
+#include "OrderPool.h"
+
+#include <cstddef>
+
+// What one submission did to its order by the time the book returned: how much filled, whether
+// the order still rests, and the last report it produced.
+struct SubmitResult {
+    // Valid while the order rests.
+    OrderHandle handle;
+    Quantity filled{};
+    std::size_t fills{};
+    ExecutionReport::Type last{ExecutionReport::Type::Accepted};
+    ExecutionReport::Reason reason{ExecutionReport::Reason::None};
+
+    [[nodiscard]] bool resting() const { return handle.valid(); }
+};
+
+#endif //ORDERBOOK_SUBMITRESULT_H
@@ -0,0 +1,28 @@
+#ifndef ORDERBOOK_SWEEPESTIMATE_H
+#define ORDERBOOK_SWEEPESTIMATE_H
+
+#include "Usings.h"
+
+#include <cstddef>
+#include <optional>
+
+// What an aggressive order of a given size would do to the book right now, ignoring its own
+// limit price: how much of it fills, at what total cost, and how deep it reaches.
+struct SweepEstimate {
+    Quantity requested{};
+    Quantity filled{};
+    // Sum of price * quantity over the fills.
+    Quantity notional{};
+    // Price of the last level the sweep reaches; nullopt if nothing fills.
+    std::optional<Price> worstPrice{};
+    std::size_t levels{};
+
+    [[nodiscard]] bool complete() const { return filled == requested; }
+
+    [[nodiscard]] std::optional<double> vwap() const {
+        if (filled == 0) return std::nullopt;
+        return static_cast<double>(notional) / static_cast<double>(filled);
+    }
+};
+
+#endif //ORDERBOOK_SWEEPESTIMATE_H
@@ -4,10 +4,12 @@
 #ifndef ORDERBOOK_USINGS_H
 #define ORDERBOOK_USINGS_H
 
+#include <cstdint>
 #include <vector>
 
 using Price = std::int32_t;
 using Quantity = std::uint64_t;
 using OrderId = std::uint64_t;
 using OrderIds = std::vector<OrderId>;
+using OwnerId = std::uint16_t;
 #endif //ORDERBOOK_USINGS_H
@@ -0,0 +1,68 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    [[noreturn]] void fail(const char *what, const std::string &path) {
+        throw std::system_error(errno, std::generic_category(), std::string{what} + " " + path);
+    }
+}
+
+MappedFile::MappedFile(const std::byte *data, std::size_t size) : data_{data}, size_{size} {
+}
+
+MappedFile MappedFile::open(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) fail("open", path);
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        fail("fstat", path);
+    }
+    const auto bytes = static_cast<std::size_t>(info.st_size);
+    if (bytes == 0) {
+        close(fd);
+        return {};
+    }
+    void *data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (data == MAP_FAILED) {
+        errno = error;
+        fail("mmap", path);
+    }
+    madvise(data, bytes, MADV_SEQUENTIAL);
+    return {static_cast<const std::byte *>(data), bytes};
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() noexcept {
+    if (data_) munmap(const_cast<std::byte *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
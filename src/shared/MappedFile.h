@@ -0,0 +1,36 @@
+#ifndef ORDERBOOK_MAPPEDFILE_H
+#define ORDERBOOK_MAPPEDFILE_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+// A whole file mapped read-only and owned by value. The mapping is private and advised for a
+// sequential pass, so the kernel reads ahead and drops pages behind the reader.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    // Throws std::system_error. An empty file gives an empty mapping.
+    static MappedFile open(const std::string &path);
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    MappedFile(const std::byte *data, std::size_t size);
+
+    void release() noexcept;
+
+    const std::byte *data_{};
+    std::size_t size_{};
+};
+
+#endif //ORDERBOOK_MAPPEDFILE_H
@@ -0,0 +1,87 @@
+#include "MappedRegion.h"
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+    std::size_t roundUp(std::size_t bytes, std::size_t to) {
+        return (bytes + to - 1) / to * to;
+    }
+
+    void *mapAnonymous(std::size_t bytes, int extraFlags) {
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // Maps bytes starting on a 2MB boundary, which transparent huge pages need.
+    void *mapHugeAligned(std::size_t bytes) {
+        const std::size_t padded = bytes + MappedRegion::HugePageSize;
+        auto *raw = static_cast<std::byte *>(mapAnonymous(padded, 0));
+        if (!raw) return nullptr;
+
+        const auto address = reinterpret_cast<std::uintptr_t>(raw);
+        auto *aligned = raw + (roundUp(address, MappedRegion::HugePageSize) - address);
+        if (aligned != raw) munmap(raw, aligned - raw);
+        if (const std::size_t tail = (raw + padded) - (aligned + bytes)) munmap(aligned + bytes, tail);
+        return aligned;
+    }
+}
+
+MappedRegion::MappedRegion(std::size_t bytes, const MemoryOptions &options) {
+    if (bytes == 0) return;
+
+    if (options.hugePages) {
+        size_ = roundUp(bytes, HugePageSize);
+        data_ = mapAnonymous(size_, MAP_HUGETLB | (options.prefault ? MAP_POPULATE : 0));
+        hugePages_ = data_ != nullptr;
+
+        if (!data_) {
+            data_ = mapHugeAligned(size_);
+            if (data_) madvise(data_, size_, MADV_HUGEPAGE);
+        }
+    } else {
+        size_ = roundUp(bytes, static_cast<std::size_t>(sysconf(_SC_PAGESIZE)));
+        data_ = mapAnonymous(size_, options.prefault ? MAP_POPULATE : 0);
+    }
+    if (!data_) throw std::bad_alloc{};
+
+    // MAP_POPULATE would fault the THP fallback in before madvise, so its pages are touched here.
+    if (options.prefault && options.hugePages && !hugePages_) {
+        const auto step = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        auto *bytesPtr = static_cast<volatile std::byte *>(data_);
+        for (std::size_t offset = 0; offset < size_; offset += step) bytesPtr[offset] = std::byte{0};
+    }
+
+    if (options.lock) locked_ = mlock(data_, size_) == 0;
+}
+
+MappedRegion::MappedRegion(MappedRegion &&other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)},
+      hugePages_{other.hugePages_}, locked_{other.locked_} {
+}
+
+MappedRegion &MappedRegion::operator=(MappedRegion &&other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        hugePages_ = other.hugePages_;
+        locked_ = other.locked_;
+    }
+    return *this;
+}
+
+MappedRegion::~MappedRegion() {
+    release();
+}
+
+void MappedRegion::release() noexcept {
+    if (!data_) return;
+    if (locked_) munlock(data_, size_);
+    munmap(data_, size_);
+    data_ = nullptr;
+}
@@ -0,0 +1,48 @@
+#ifndef ORDERBOOK_MAPPEDREGION_H
+#define ORDERBOOK_MAPPEDREGION_H
+
+#include <cstddef>
+
+// How a book backs its level arrays and order storage. The defaults keep the plain lazily
+// faulted mapping; a latency-sensitive session turns everything on before the first event.
+struct MemoryOptions {
+    bool hugePages = false; // 2MB pages: MAP_HUGETLB, else transparent huge pages via madvise
+    bool prefault = false; // touch every page at construction
+    bool lock = false; // mlock the mappings; silently skipped if RLIMIT_MEMLOCK is too small
+    std::size_t reservedOrders = 0; // order nodes mapped up front with the options above
+};
+
+// Anonymous zero-filled mapping owned by value.
+class MappedRegion {
+public:
+    static constexpr std::size_t HugePageSize = std::size_t{2} << 20;
+
+    MappedRegion() = default;
+
+    MappedRegion(std::size_t bytes, const MemoryOptions &options);
+
+    MappedRegion(MappedRegion &&other) noexcept;
+
+    MappedRegion &operator=(MappedRegion &&other) noexcept;
+
+    ~MappedRegion();
+
+    [[nodiscard]] void *data() const { return data_; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    // True when the region came from the hugetlb pool; a THP fallback reports false.
+    [[nodiscard]] bool onHugePages() const { return hugePages_; }
+
+    [[nodiscard]] bool locked() const { return locked_; }
+
+private:
+    void release() noexcept;
+
+    void *data_{};
+    std::size_t size_{};
+    bool hugePages_{false};
+    bool locked_{false};
+};
+
+#endif //ORDERBOOK_MAPPEDREGION_H
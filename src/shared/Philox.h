@@ -0,0 +1,104 @@
+#ifndef ORDERBOOK_PHILOX_H
+#define ORDERBOOK_PHILOX_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// Every (key, counter) pair maps to four independent 32-bit words, so any stream can be
+// opened at any position on any thread and still produce exactly the same numbers.
+class Philox4x32 {
+public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    static constexpr Counter generate(Counter ctr, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            ctr = singleRound(ctr, key);
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+
+private:
+    static constexpr std::uint32_t M0 = 0xD2511F53;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57;
+    static constexpr std::uint32_t W0 = 0x9E3779B9;
+    static constexpr std::uint32_t W1 = 0xBB67AE85;
+
+    static constexpr Counter singleRound(const Counter &ctr, const Key &key) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * ctr[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * ctr[2];
+        return {
+            static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+            static_cast<std::uint32_t>(p1),
+            static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+            static_cast<std::uint32_t>(p0)
+        };
+    }
+};
+
+// A sequential view over one Philox stream, identified by (seed, stream, domain).
+// Satisfies UniformRandomBitGenerator so it can also drive std:: algorithms.
+class PhiloxStream {
+public:
+    using result_type = std::uint64_t;
+
+    PhiloxStream(std::uint64_t seed, std::uint64_t stream, std::uint32_t domain)
+        : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          stream_{stream}, domain_{domain} {
+    }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (pos_ == buffer_.size()) refill();
+        const std::uint64_t lo = buffer_[pos_++];
+        const std::uint64_t hi = buffer_[pos_++];
+        return (hi << 32) | lo;
+    }
+
+    // Uniform on [0, 1) with 53 bits of precision.
+    double uniform() {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Box-Muller, discarding the sine half so every call consumes exactly two draws.
+    double normal() {
+        const double u1 = 1.0 - uniform();
+        const double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+    }
+
+    // Uniform integer on [0, bound) via Lemire's multiply-shift.
+    std::uint64_t below(std::uint64_t bound) {
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>((*this)()) * bound) >> 64);
+    }
+
+private:
+    void refill() {
+        buffer_ = Philox4x32::generate(
+            {
+                static_cast<std::uint32_t>(block_), static_cast<std::uint32_t>(stream_),
+                static_cast<std::uint32_t>(stream_ >> 32), domain_
+            }, key_);
+        ++block_;
+        pos_ = 0;
+    }
+
+    Philox4x32::Key key_;
+    std::uint64_t stream_;
+    std::uint32_t domain_;
+    std::uint32_t block_{0};
+    Philox4x32::Counter buffer_{};
+    std::size_t pos_{buffer_.size()};
+};
+
+#endif //ORDERBOOK_PHILOX_H
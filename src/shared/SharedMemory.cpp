@@ -0,0 +1,96 @@
+#include "SharedMemory.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    [[noreturn]] void fail(const char *what, const std::string &name) {
+        throw std::system_error(errno, std::generic_category(), std::string{what} + " " + name);
+    }
+
+    void *mapShared(int fd, std::size_t bytes, int extraFlags) {
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | extraFlags, fd, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+}
+
+SharedMemory::SharedMemory(std::string name, void *data, std::size_t size, bool owner)
+    : name_{std::move(name)}, data_{data}, size_{size}, owner_{owner} {
+}
+
+SharedMemory SharedMemory::create(const std::string &name, std::size_t bytes) {
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) fail("shm_open", name);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        const int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        errno = error;
+        fail("ftruncate", name);
+    }
+    void *data = mapShared(fd, bytes, MAP_POPULATE);
+    const int error = errno;
+    close(fd);
+    if (!data) {
+        shm_unlink(name.c_str());
+        errno = error;
+        fail("mmap", name);
+    }
+    return {name, data, bytes, true};
+}
+
+SharedMemory SharedMemory::open(const std::string &name) {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) fail("shm_open", name);
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        fail("fstat", name);
+    }
+    const auto bytes = static_cast<std::size_t>(info.st_size);
+    void *data = mapShared(fd, bytes, 0);
+    const int error = errno;
+    close(fd);
+    if (!data) {
+        errno = error;
+        fail("mmap", name);
+    }
+    return {name, data, bytes, false};
+}
+
+SharedMemory::SharedMemory(SharedMemory &&other) noexcept
+    : name_{std::move(other.name_)}, data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)}, owner_{std::exchange(other.owner_, false)} {
+}
+
+SharedMemory &SharedMemory::operator=(SharedMemory &&other) noexcept {
+    if (this != &other) {
+        release();
+        name_ = std::move(other.name_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        owner_ = std::exchange(other.owner_, false);
+    }
+    return *this;
+}
+
+SharedMemory::~SharedMemory() {
+    release();
+}
+
+void SharedMemory::release() noexcept {
+    if (data_) munmap(data_, size_);
+    if (owner_) shm_unlink(name_.c_str());
+    data_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+}
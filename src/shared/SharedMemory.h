@@ -0,0 +1,53 @@
+#ifndef ORDERBOOK_SHAREDMEMORY_H
+#define ORDERBOOK_SHAREDMEMORY_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A named POSIX shared memory object (shm_open), mapped read/write and owned by value. The
+// process that created the name unlinks it again on destruction; openers only unmap.
+class SharedMemory {
+public:
+    SharedMemory() = default;
+
+    // Creates a zero-filled object of bytes under name, replacing any stale one left by a crash.
+    // name is a single path component, e.g. "/orderbook_replica". The pages are populated up front,
+    // so the first write to each does not fault on the hot path. Throws std::system_error.
+    static SharedMemory create(const std::string &name, std::size_t bytes);
+
+    // Maps the whole of an existing object. Throws std::system_error.
+    static SharedMemory open(const std::string &name);
+
+    SharedMemory(SharedMemory &&other) noexcept;
+
+    SharedMemory &operator=(SharedMemory &&other) noexcept;
+
+    ~SharedMemory();
+
+    [[nodiscard]] void *data() const { return data_; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    [[nodiscard]] const std::string &name() const { return name_; }
+
+private:
+    SharedMemory(std::string name, void *data, std::size_t size, bool owner);
+
+    void release() noexcept;
+
+    std::string name_;
+    void *data_{};
+    std::size_t size_{};
+    bool owner_{false};
+};
+
+// steady_clock (CLOCK_MONOTONIC) in nanoseconds. Every process on the host shares it, so a timestamp
+// written into shared memory can be compared with the reader's own clock.
+inline std::uint64_t sharedClockNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif //ORDERBOOK_SHAREDMEMORY_H
@@ -0,0 +1,71 @@
+#ifndef ORDERBOOK_SPSCRING_H
+#define ORDERBOOK_SPSCRING_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+// Bounded single-producer/single-consumer ring. Neither side ever blocks: a full ring
+// rejects the push and an empty ring yields nothing. Capacity is rounded up to a power of two.
+template<class T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity)
+        : buffer_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)), mask_{buffer_.size() - 1} {
+    }
+
+    SpscRing(const SpscRing &) = delete;
+
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    bool tryPush(const T &value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == buffer_.size()) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == buffer_.size()) return false;
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        out = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every available element to f and publishes the new head once; returns the count.
+    template<class F>
+    std::size_t drain(F &&f) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        for (std::size_t i = head; i != tail; ++i) {
+            f(buffer_[i & mask_]);
+        }
+        head_.store(tail, std::memory_order_release);
+        return tail - head;
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return buffer_.size(); }
+
+private:
+    static constexpr std::size_t CacheLine = 64;
+
+    std::vector<T> buffer_;
+    std::size_t mask_;
+
+    alignas(CacheLine) std::atomic<std::size_t> head_{0};
+    std::size_t cachedTail_{0};
+
+    alignas(CacheLine) std::atomic<std::size_t> tail_{0};
+    std::size_t cachedHead_{0};
+};
+
+#endif //ORDERBOOK_SPSCRING_H
@@ -0,0 +1,96 @@
+#ifndef ORDERBOOK_WORKSTEALINGPOOL_H
+#define ORDERBOOK_WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a fixed set of independent tasks, numbered 0..count-1, on a number of workers. Tasks are
+// dealt round robin, in the order given, onto one deque per worker. A worker takes its own tasks
+// from the front; once its deque is empty it steals from the back of the others', so workers that
+// drew short tasks take over the tail of the ones that drew long tasks. Give tasks longest first.
+//
+// Tasks are coarse (a whole file, a whole day), so each deque is a mutex and a std::deque; the lock
+// is taken once per task. The calling thread is worker 0; the others live for the duration of run().
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t workers = defaultWorkers()) : workers_{std::max<std::size_t>(workers, 1)} {}
+
+    static std::size_t defaultWorkers() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+    [[nodiscard]] std::size_t workers() const { return workers_; }
+
+    // Calls f(task, worker) once for every task and returns when all have finished. If a task
+    // throws, the remaining tasks are dropped and the first exception is rethrown here.
+    template<class F>
+    void run(std::size_t count, F &&f) {
+        const std::size_t workers = std::min(workers_, std::max<std::size_t>(count, 1));
+        std::vector<std::unique_ptr<Queue> > queues;
+        queues.reserve(workers);
+        for (std::size_t w = 0; w < workers; ++w) queues.push_back(std::make_unique<Queue>());
+        for (std::size_t task = 0; task < count; ++task) queues[task % workers]->tasks.push_back(task);
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        const auto work = [&](std::size_t self) {
+            std::size_t task;
+            while (next(queues, self, task)) {
+                try {
+                    f(task, self);
+                } catch (...) {
+                    std::scoped_lock _{errorMutex};
+                    if (!error) error = std::current_exception();
+                    for (const auto &queue: queues) {
+                        std::scoped_lock lock{queue->mutex};
+                        queue->tasks.clear();
+                    }
+                }
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t w = 1; w < workers; ++w) threads.emplace_back(work, w);
+        work(0);
+        threads.clear();
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    // No task is ever added during a run, so a worker that finds every deque empty is done.
+    static bool next(const std::vector<std::unique_ptr<Queue> > &queues, std::size_t self, std::size_t &task) {
+        {
+            Queue &own = *queues[self];
+            std::scoped_lock _{own.mutex};
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t i = 1; i < queues.size(); ++i) {
+            Queue &victim = *queues[(self + i) % queues.size()];
+            std::scoped_lock _{victim.mutex};
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t workers_;
+};
+
+#endif //ORDERBOOK_WORKSTEALINGPOOL_H
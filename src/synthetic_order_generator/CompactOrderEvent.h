@@ -0,0 +1,82 @@
+#ifndef ORDERBOOK_COMPACTORDEREVENT_H
+#define ORDERBOOK_COMPACTORDEREVENT_H
+
+#include "OrderEvent.h"
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Flat, trivially copyable form of OrderEvent used for replay buffers. Every event kind shares the
+// same fields, so dispatch is a switch on event instead of a std::visit over a variant.
+struct CompactOrderEvent {
+    OrderId id{};
+    Quantity quantity{};
+    Price price{};
+    EventType event{};
+    OrderType orderType{};
+    Side side{};
+
+    static CompactOrderEvent New(const Order &o) {
+        return {o.getId(), o.getRemainingQuantity(), o.getPrice(), EventType::New, o.getType(), o.getSide()};
+    }
+
+    static CompactOrderEvent Modify(const OrderModify &m) {
+        return {m.getId(), m.getQuantity(), m.getPrice(), EventType::Modify, OrderType{}, m.getSide()};
+    }
+
+    static CompactOrderEvent Cancel(OrderId id) {
+        return {id, 0, 0, EventType::Cancel, OrderType{}, Side{}};
+    }
+
+    static CompactOrderEvent from(const OrderEvent &e) {
+        return std::visit(Overloaded{
+                              [](Order const &o) { return New(o); },
+                              [](OrderModify const &m) { return Modify(m); },
+                              [](OrderId const &id) { return Cancel(id); }
+                          }, e.payload);
+    }
+
+    [[nodiscard]] Order toOrder() const {
+        return {id, orderType, side, price, quantity};
+    }
+
+    [[nodiscard]] OrderModify toOrderModify() const {
+        return {id, side, price, quantity};
+    }
+
+    [[nodiscard]] OrderEvent toOrderEvent() const {
+        switch (event) {
+            case EventType::New: return OrderEvent::New(toOrder());
+            case EventType::Modify: return OrderEvent::Modify(toOrderModify());
+            case EventType::Cancel: break;
+        }
+        return OrderEvent::Cancel(id);
+    }
+
+    // Same CSV layout as OrderEvent, so persisted files load with either representation.
+    friend std::ostream &operator<<(std::ostream &os, const CompactOrderEvent &e) {
+        os << +std::to_underlying(e.event) << "," << e.id;
+        switch (e.event) {
+            case EventType::New:
+                os << "," << +std::to_underlying(e.orderType)
+                        << "," << +std::to_underlying(e.side)
+                        << "," << e.price
+                        << "," << e.quantity;
+                break;
+            case EventType::Modify:
+                os << "," << +std::to_underlying(e.side)
+                        << "," << e.price
+                        << "," << e.quantity;
+                break;
+            case EventType::Cancel: break;
+        }
+        return os << "\n";
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<CompactOrderEvent>);
+static_assert(sizeof(CompactOrderEvent) == 24);
+
+#endif //ORDERBOOK_COMPACTORDEREVENT_H
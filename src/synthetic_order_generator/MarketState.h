@@ -5,11 +5,16 @@
 #ifndef ORDERBOOK_MARKETSTATE_H
 #define ORDERBOOK_MARKETSTATE_H
 
+#include <cstdint>
+
 struct MarketState {
     double mid = 100.0;
     double drift = 0.1;
     double sigma = 0.2;
     double dt = 0.0001;
     double b = 0.001;
+    std::uint64_t seed = 42;
+    // Worker threads used to draw tick ranges; the generated flow is identical for any value.
+    unsigned threads = 1;
 };
-#endif //ORDERBOOK_MARKETSTATE_H
\ No newline at end of file
+#endif //ORDERBOOK_MARKETSTATE_H
@@ -4,6 +4,7 @@
 #ifndef ORDERBOOK_ORDEREVENT_H
 #define ORDERBOOK_ORDEREVENT_H
 
+#include <cstdint>
 #include <variant>
 #include <type_traits>
 #include <ostream>
@@ -19,7 +20,7 @@ struct Overloaded : Ts... {
 template<class... Ts>
 Overloaded(Ts...) -> Overloaded<Ts...>;
 
-enum class EventType : int {
+enum class EventType : std::uint8_t {
     New = 0, Cancel = 1, Modify = 2
 };
 
@@ -42,24 +43,24 @@ struct OrderEvent {
     friend std::ostream &operator<<(std::ostream &os, const OrderEvent &e) {
         std::visit(Overloaded{
                        [&](Order const &o) {
-                           os << std::to_underlying(EventType::New)
+                           os << +std::to_underlying(EventType::New)
                                    << "," << o.getId()
-                                   << "," << std::to_underlying(o.getType())
-                                   << "," << std::to_underlying(o.getSide())
+                                   << "," << +std::to_underlying(o.getType())
+                                   << "," << +std::to_underlying(o.getSide())
                                    << "," << o.getPrice()
                                    << "," << o.getRemainingQuantity()
                                    << "\n";
                        },
                        [&](OrderModify const &m) {
-                           os << std::to_underlying(EventType::Modify)
+                           os << +std::to_underlying(EventType::Modify)
                                    << "," << m.getId()
-                                   << "," << std::to_underlying(m.getSide())
+                                   << "," << +std::to_underlying(m.getSide())
                                    << "," << m.getPrice()
                                    << "," << m.getQuantity()
                                    << "\n";
                        },
                        [&](OrderId const &id) {
-                           os << std::to_underlying(EventType::Cancel)
+                           os << +std::to_underlying(EventType::Cancel)
                                    << "," << id
                                    << "\n";
                        }
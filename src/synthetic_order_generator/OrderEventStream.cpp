@@ -0,0 +1,66 @@
+#include "OrderEventStream.h"
+
+#include <utility>
+
+OrderEventStream::OrderEventStream(OrderGenerator &generator) : generator_{generator} {
+    producer_ = std::thread([this] { produce(); });
+}
+
+OrderEventStream::~OrderEventStream() {
+    {
+        std::scoped_lock lock{mutex_};
+        shutdown_ = true;
+    }
+    cv_.notify_all();
+    if (producer_.joinable()) producer_.join();
+}
+
+std::span<const CompactOrderEvent> OrderEventStream::next() {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [&] { return hasPending_ || finished_; });
+
+    if (!hasPending_) {
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+        front_.clear();
+        return {};
+    }
+
+    std::swap(front_, pending_);
+    hasPending_ = false;
+    lock.unlock();
+    cv_.notify_all();
+    return front_;
+}
+
+void OrderEventStream::produce() {
+    try {
+        while (true) {
+            back_.clear();
+            const bool more = generator_.generateChunk(back_);
+            if (more && back_.empty()) continue;
+
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [&] { return !hasPending_ || shutdown_; });
+            if (shutdown_) return;
+
+            if (!more) {
+                finished_ = true;
+                lock.unlock();
+                cv_.notify_all();
+                return;
+            }
+
+            std::swap(pending_, back_);
+            hasPending_ = true;
+            lock.unlock();
+            cv_.notify_all();
+        }
+    } catch (...) {
+        {
+            std::scoped_lock lock{mutex_};
+            error_ = std::current_exception();
+            finished_ = true;
+        }
+        cv_.notify_all();
+    }
+}
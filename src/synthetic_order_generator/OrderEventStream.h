@@ -0,0 +1,90 @@
+#ifndef ORDERBOOK_ORDEREVENTSTREAM_H
+#define ORDERBOOK_ORDEREVENTSTREAM_H
+
+#include "OrderGenerator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Pull-based view over an OrderGenerator. A producer thread generates the next chunk while the
+// consumer works through the current one, and the three chunk buffers are recycled, so a run of
+// any length only ever holds a handful of chunks in memory.
+class OrderEventStream {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = CompactOrderEvent;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const CompactOrderEvent *;
+        using reference = const CompactOrderEvent &;
+
+        Iterator() = default;
+
+        explicit Iterator(OrderEventStream *stream) : stream_{stream}, chunk_{stream->next()} {
+        }
+
+        reference operator*() const { return chunk_[pos_]; }
+
+        pointer operator->() const { return &chunk_[pos_]; }
+
+        Iterator &operator++() {
+            if (++pos_ == chunk_.size()) {
+                chunk_ = stream_->next();
+                pos_ = 0;
+            }
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator &it, std::default_sentinel_t) { return it.chunk_.empty(); }
+
+    private:
+        OrderEventStream *stream_{};
+        std::span<const CompactOrderEvent> chunk_{};
+        std::size_t pos_{};
+    };
+
+    explicit OrderEventStream(OrderGenerator &generator);
+
+    ~OrderEventStream();
+
+    OrderEventStream(const OrderEventStream &) = delete;
+
+    OrderEventStream &operator=(const OrderEventStream &) = delete;
+
+    // Blocks until the next chunk is ready. The span stays valid until the following call;
+    // an empty span means the generator is exhausted.
+    std::span<const CompactOrderEvent> next();
+
+    Iterator begin() { return Iterator{this}; }
+
+    static std::default_sentinel_t end() { return std::default_sentinel; }
+
+private:
+    void produce();
+
+    OrderGenerator &generator_;
+
+    std::vector<CompactOrderEvent> front_;
+    std::vector<CompactOrderEvent> pending_;
+    std::vector<CompactOrderEvent> back_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool hasPending_{false};
+    bool finished_{false};
+    bool shutdown_{false};
+    std::exception_ptr error_{};
+
+    std::thread producer_;
+};
+
+#endif //ORDERBOOK_ORDEREVENTSTREAM_H
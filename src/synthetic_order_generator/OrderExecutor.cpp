@@ -23,66 +23,61 @@ const std::unique_ptr<Orderbook>& OrderExecutor::getOrderbook() {
     return orderbook_;
 }
 
-double OrderExecutor::executeOrders(const std::vector<OrderEvent> &events) const {
+void OrderExecutor::apply(Orderbook &book, const CompactOrderEvent &e) {
+    switch (e.event) {
+        case EventType::New: book.addOrder(e.toOrder());
+            break;
+        case EventType::Cancel: book.cancelOrder(e.id);
+            break;
+        case EventType::Modify: book.modifyOrder(e.toOrderModify());
+            break;
+    }
+}
+
+void OrderExecutor::execute(const CompactOrderEvent &e) const {
+    apply(*orderbook_, e);
+}
+
+double OrderExecutor::executeOrders(const std::vector<CompactOrderEvent> &events) const {
     const Timer timer;
 
     for (const auto &e: events) {
-        std::visit(Overloaded{
-                       [&](Order const &o) {
-                           orderbook_->addOrder(o);
-                       },
-                       [&](OrderModify const &m) {
-                           orderbook_->modifyOrder(m);
-                       },
-                       [&](OrderId const &id) {
-                           orderbook_->cancelOrder(id);
-                       }
-                   }, e.payload);
+        execute(e);
     }
 
     return timer.elapsed();
 }
 
-
-double OrderExecutor::executeOrdersPersist(const std::vector<OrderEvent> &events) const {
-    const Timer timer;
-    std::ofstream file(persist_path_, std::ios::out | std::ios::trunc);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open persist file: " + persist_path_);
+double OrderExecutor::runFromSimulation() {
+    std::ofstream file;
+    if (!persist_path_.empty()) {
+        file.open(persist_path_, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open persist file: " + persist_path_);
+        }
     }
-    for (const auto &e: events) {
-        std::visit(Overloaded{
-                       [&](Order const &o) {
-                           orderbook_->addOrder(o);
-                       },
-                       [&](OrderModify const &m) {
-                           orderbook_->modifyOrder(m);
-                       },
-                       [&](OrderId const &id) {
-                           orderbook_->cancelOrder(id);
-                       }
-                   }, e.payload);
 
-        file << e;
+    const Timer timer;
+    OrderEventStream stream{generator_};
+    for (auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) {
+        for (const auto &e: chunk) {
+            execute(e);
+        }
+        if (file.is_open()) {
+            for (const auto &e: chunk) file << e;
+        }
     }
     file.flush();
-    const auto duration = timer.elapsed();
-    return duration;
-}
-
-double OrderExecutor::runFromSimulation() {
-    const std::vector<OrderEvent> events = generator_.generate();
-    if (persist_path_.empty()) return executeOrders(events);
-    else return executeOrdersPersist(events);
+    return timer.elapsed();
 }
 
 double OrderExecutor::runFromCsv(const std::string &csv_path) const {
-    const std::vector<OrderEvent> orders = getOrdersFromCsv(csv_path);
+    const std::vector<CompactOrderEvent> orders = getOrdersFromCsv(csv_path);
     return executeOrders(orders);
 }
 
-std::vector<OrderEvent> OrderExecutor::getOrdersFromCsv(const std::string &path) {
-    std::vector<OrderEvent> events;
+std::vector<CompactOrderEvent> OrderExecutor::getOrdersFromCsv(const std::string &path) {
+    std::vector<CompactOrderEvent> events;
     std::ifstream file(path);
     std::string str;
     while (std::getline(file, str)) {
@@ -99,24 +94,24 @@ std::vector<OrderEvent> OrderExecutor::getOrdersFromCsv(const std::string &path)
         int action = std::stoi(members[0]);
 
         if (action == static_cast<int>(EventType::New)) {
-            events.emplace_back(EventType::New,
-                                Order{
-                                    static_cast<OrderId>(std::stoll(members[1])),
-                                    static_cast<OrderType>(std::stoi(members[2])),
-                                    static_cast<Side>(std::stoi(members[3])),
-                                    static_cast<Price>(std::stoll(members[4])),
-                                    static_cast<Quantity>(std::stoll(members[5]))
-                                });
+            events.push_back(CompactOrderEvent::New(
+                Order{
+                    static_cast<OrderId>(std::stoll(members[1])),
+                    static_cast<OrderType>(std::stoi(members[2])),
+                    static_cast<Side>(std::stoi(members[3])),
+                    static_cast<Price>(std::stoll(members[4])),
+                    static_cast<Quantity>(std::stoll(members[5]))
+                }));
         } else if (action == static_cast<int>(EventType::Modify)) {
-            events.emplace_back(EventType::Modify,
-                                OrderModify{
-                                    static_cast<OrderId>(std::stoll(members[1])),
-                                    static_cast<Side>(std::stoi(members[2])),
-                                    static_cast<Price>(std::stoll(members[3])),
-                                    static_cast<Quantity>(std::stoll(members[4]))
-                                });
+            events.push_back(CompactOrderEvent::Modify(
+                OrderModify{
+                    static_cast<OrderId>(std::stoll(members[1])),
+                    static_cast<Side>(std::stoi(members[2])),
+                    static_cast<Price>(std::stoll(members[3])),
+                    static_cast<Quantity>(std::stoll(members[4]))
+                }));
         } else if (action == static_cast<int>(EventType::Cancel)) {
-            events.push_back(OrderEvent::Cancel(static_cast<OrderId>(std::stoll(members[1]))));
+            events.push_back(CompactOrderEvent::Cancel(static_cast<OrderId>(std::stoll(members[1]))));
         }
     }
     return events;
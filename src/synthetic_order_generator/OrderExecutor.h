@@ -3,6 +3,7 @@
 
 #include "orderbook/Orderbook.h"
 #include "OrderGenerator.h"
+#include "OrderEventStream.h"
 #include "shared/Timer.h"
 
 #include <cstddef>
@@ -19,18 +20,21 @@ public:
 
     const std::unique_ptr<Orderbook>& getOrderbook();
 
+    static std::vector<CompactOrderEvent> getOrdersFromCsv(const std::string &path);
+
+    static void apply(Orderbook &book, const CompactOrderEvent &e);
+
 private:
     std::unique_ptr<Orderbook> orderbook_ = std::make_unique<Orderbook>(true);
     OrderGenerator generator_{MarketState{}, 100000};
     std::string persist_path_{};
 
-    static std::vector<OrderEvent> getOrdersFromCsv(const std::string &path);
-
+    // Streams the generator straight into the book, persisting each chunk when a path is set.
     double runFromSimulation();
 
-    [[nodiscard]] double executeOrders(const std::vector<OrderEvent> &events) const;
+    void execute(const CompactOrderEvent &e) const;
 
-    [[nodiscard]] double executeOrdersPersist(const std::vector<OrderEvent> &events) const;
+    [[nodiscard]] double executeOrders(const std::vector<CompactOrderEvent> &events) const;
 
     [[nodiscard]] double runFromCsv(const std::string &csv_path) const;
 
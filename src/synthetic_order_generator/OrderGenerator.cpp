@@ -1,17 +1,50 @@
 #include "OrderGenerator.h"
 
+#include <cassert>
 #include <cmath>
-#include <cstdlib>
 #include <algorithm>
+#include <thread>
 #include <vector>
 
-Quantity OrderGenerator::getRandomQuantity() {
-    return static_cast<Quantity>(std::abs(getRandom()) * 100 + 1);
+namespace {
+    template<class F>
+    void runParallel(size_t taskCount, F &&task) {
+        if (taskCount <= 1) {
+            if (taskCount == 1) task(0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(taskCount - 1);
+        for (size_t i = 1; i < taskCount; ++i) {
+            workers.emplace_back([&task, i] { task(i); });
+        }
+        task(0);
+        for (auto &worker: workers) worker.join();
+    }
+}
+
+OrderGenerator::OrderGenerator(MarketState state, size_t ticks)
+    : state_{state}, ticks_{ticks}, mid_{state.mid},
+      logDrift_{(state.drift - 0.5 * state.sigma * state.sigma) * state.dt},
+      logVol_{std::sqrt(state.dt) * state.sigma}, ranges_(std::max(1u, state.threads)) {
+    const double lambda = eventsPerTick;
+    double p = std::exp(-lambda);
+    double cdf = 0.0;
+    for (int k = 0; k <= 5 * eventsPerTick; ++k) {
+        cdf += p;
+        eventCountCdf_.push_back(cdf);
+        p *= lambda / (k + 1);
+    }
 }
 
-Price OrderGenerator::getRandomOrderPrice(double mid, Side side) {
-    const double uSample = getUSample();
-    const double d = -state_.b * std::log(1 - 2 * std::abs(uSample));
+Quantity OrderGenerator::getRandomQuantity(PhiloxStream &rng) {
+    return static_cast<Quantity>(std::abs(rng.normal()) * 100 + 1);
+}
+
+Price OrderGenerator::getRandomOrderPrice(double mid, Side side, PhiloxStream &rng) const {
+    // |U(-0.5, 0.5)| folded directly: 1 - 2|u| is uniform on (0, 1].
+    const double d = -state_.b * std::log(1.0 - rng.uniform());
 
     const double spread = (side == Side::Buy) ? std::exp(-d) : std::exp(d);
     const double raw = Constants::TICK_MULTIPLIER * mid * spread;
@@ -19,119 +52,175 @@ Price OrderGenerator::getRandomOrderPrice(double mid, Side side) {
     return std::max<Price>(1, static_cast<Price>(std::llround(raw)));
 }
 
-OrderType OrderGenerator::getRandomOrderType() {
-    int type = static_cast<int>(OrderType::Size) * uniformZeroToOne_(rng_);
+OrderType OrderGenerator::getRandomOrderType(PhiloxStream &rng) {
+    int type = static_cast<int>(static_cast<int>(OrderType::Size) * rng.uniform());
     return static_cast<OrderType>(type);
 }
 
-Side OrderGenerator::getRandomSide() {
-    return bernoulliDist_(rng_) ? Side::Sell : Side::Buy;
+Side OrderGenerator::getRandomSide(PhiloxStream &rng) {
+    return rng.uniform() < 0.5 ? Side::Buy : Side::Sell;
 }
 
-std::vector<OrderEvent> OrderGenerator::generate() {
-    double mid = state_.mid;
-    const double sigma = state_.sigma;
-    const double drift = state_.drift;
-    const double dt = state_.dt;
+int OrderGenerator::getRandomEventCount(PhiloxStream &rng) const {
+    const double u = rng.uniform();
+    const int last = static_cast<int>(eventCountCdf_.size()) - 1;
+    int k = 0;
+    while (k < last && u >= eventCountCdf_[k]) ++k;
+    return k;
+}
 
-    std::vector<OrderEvent> orders;
-    orders.reserve(ticks_);
+std::vector<CompactOrderEvent> OrderGenerator::generate() {
+    assert(ticks_ != Unbounded && "An unbounded generator must be consumed with generateChunk");
 
-    for (size_t i = 0; i < ticks_; ++i) {
-        mid = mid * std::exp((drift - 0.5 * std::pow(sigma, 2)) * dt
-                             + std::sqrt(dt) * sigma * getRandom());
-        int eventCount = eventCountDist_(rng_);
+    std::vector<CompactOrderEvent> orders;
+    orders.reserve((ticks_ - nextTick_) * eventsPerTick);
+    while (generateChunk(orders)) {
+    }
+    return orders;
+}
 
-        int addCount = 0, cancelCount = 0, modifyCount = 0;
-        for (int k = 0; k < eventCount; ++k) {
-            auto type = static_cast<EventType>(eventTypeDist_(rng_));
-            switch (type) {
-                case EventType::New: ++addCount;
-                    break;
-                case EventType::Cancel: ++cancelCount;
-                    break;
-                case EventType::Modify: ++modifyCount;
-                    break;
-            }
-        }
+bool OrderGenerator::generateChunk(std::vector<CompactOrderEvent> &out) {
+    if (nextTick_ >= ticks_) return false;
 
-        std::vector<OrderEvent> eventBucket;
-        eventBucket.reserve(addCount + cancelCount + modifyCount);
+    const size_t threads = ranges_.size();
+    const size_t roundFirst = nextTick_;
+    const size_t roundCount = std::min(ticksPerRange * threads, ticks_ - nextTick_);
+    const size_t rangeCount = (roundCount + ticksPerRange - 1) / ticksPerRange;
 
-        //Cancels/Modify first so we do not cancel orders in the same burst as we add them.
-        generateCancelOrderEvents(cancelCount, eventBucket);
-        generateAddOrderEvents(mid, addCount, eventBucket);
+    generateMidPath(roundFirst, roundCount, mids_);
+
+    runParallel(rangeCount, [&](size_t r) {
+        const size_t offset = r * ticksPerRange;
+        auto &range = ranges_[r];
+        range.firstTick = roundFirst + offset;
+        range.tickCount = std::min(ticksPerRange, roundCount - offset);
+        drawTickRange(mids_.data() + offset, range);
+    });
 
-        std::shuffle(eventBucket.begin(), eventBucket.end(), rng_);
-        for (const auto &event: eventBucket) {
-            orders.push_back(event);
+    for (size_t r = 0; r < rangeCount; ++r) {
+        mergeTickRange(ranges_[r], out);
+    }
+    nextTick_ += roundCount;
+    return true;
+}
+
+void OrderGenerator::generateMidPath(size_t firstTick, size_t tickCount, std::vector<double> &mids) {
+    mids.resize(tickCount);
+
+    // The per-tick factors are independent, only the running product is serial.
+    const size_t threads = ranges_.size();
+    const size_t chunk = (tickCount + threads - 1) / threads;
+    runParallel(std::min(threads, tickCount), [&](size_t w) {
+        const size_t end = std::min(tickCount, (w + 1) * chunk);
+        for (size_t t = w * chunk; t < end; ++t) {
+            PhiloxStream rng{state_.seed, firstTick + t, MidPath};
+            mids[t] = std::exp(logDrift_ + logVol_ * rng.normal());
         }
+    });
+
+    for (auto &mid: mids) {
+        mid_ = mid_ * mid;
+        mid = mid_;
     }
-    return orders;
 }
 
+void OrderGenerator::drawTickRange(const double *mids, TickRange &range) const {
+    range.cancelCounts.clear();
+    range.addCounts.clear();
+    range.cancelDraws.clear();
+    range.adds.clear();
+    range.adds.reserve(range.tickCount * eventsPerTick);
 
-void OrderGenerator::generateAddOrderEvents(double mid, int addCount, std::vector<OrderEvent> &out) {
-    if (addCount <= 0) return;
+    for (size_t t = 0; t < range.tickCount; ++t) {
+        PhiloxStream rng{state_.seed, range.firstTick + t, TickDraws};
+
+        const int eventCount = getRandomEventCount(rng);
+        std::uint32_t addCount = 0, cancelCount = 0;
+        for (int k = 0; k < eventCount; ++k) {
+            if (rng.uniform() < addOdds) ++addCount;
+            else ++cancelCount;
+        }
+        range.addCounts.push_back(addCount);
+        range.cancelCounts.push_back(cancelCount);
+
+        for (std::uint32_t i = 0; i < cancelCount; ++i) {
+            range.cancelDraws.push_back(rng.uniform());
+        }
+        for (std::uint32_t i = 0; i < addCount; ++i) {
+            const Side side = getRandomSide(rng);
+            const Price px = getRandomOrderPrice(mids[t], side, rng);
+            const OrderType type = getRandomOrderType(rng);
+            range.adds.push_back({type, side, px, getRandomQuantity(rng)});
+        }
+    }
+}
 
-    out.reserve(out.size() + static_cast<size_t>(addCount));
+void OrderGenerator::mergeTickRange(const TickRange &range, std::vector<CompactOrderEvent> &out) {
+    const double *cancelDraws = range.cancelDraws.data();
+    const PendingOrder *adds = range.adds.data();
 
-    for (int i = 0; i < addCount; ++i) {
-        const Side side = getRandomSide();
-        const Price px = getRandomOrderPrice(mid, side);
-        const OrderType type = getRandomOrderType();
+    for (size_t t = 0; t < range.tickCount; ++t) {
+        const size_t bucketBegin = out.size();
 
-        auto newOrder{Order{nextId_++, type, side, px, getRandomQuantity()}};
-        out.emplace_back(
-            EventType::New,
-            newOrder
-        );
-        registry_.onNew(newOrder);
+        //Cancels/Modify first so we do not cancel orders in the same burst as we add them.
+        generateCancelOrderEvents(cancelDraws, range.cancelCounts[t], out);
+        generateAddOrderEvents(adds, range.addCounts[t], out);
+        cancelDraws += range.cancelCounts[t];
+        adds += range.addCounts[t];
+
+        PhiloxStream rng{state_.seed, range.firstTick + t, Merge};
+        for (size_t i = out.size() - bucketBegin; i > 1; --i) {
+            std::swap(out[bucketBegin + i - 1], out[bucketBegin + rng.below(i)]);
+        }
     }
 }
 
-void OrderGenerator::generateCancelOrderEvents(int cancelCount, std::vector<OrderEvent> &out) {
-    if (cancelCount <= 0) return;
+void OrderGenerator::generateAddOrderEvents(const PendingOrder *adds, std::uint32_t addCount,
+                                            std::vector<CompactOrderEvent> &out) {
+    for (std::uint32_t i = 0; i < addCount; ++i) {
+        const auto &[type, side, px, quantity] = adds[i];
 
-    out.reserve(out.size() + static_cast<size_t>(cancelCount));
+        auto newOrder{Order{nextId_++, type, side, px, quantity}};
+        out.push_back(CompactOrderEvent::New(newOrder));
+        registry_.onNew(newOrder);
+    }
+}
 
-    for (int i = 0; i < cancelCount; ++i) {
-        auto order = registry_.randomLive(rng_);
+void OrderGenerator::generateCancelOrderEvents(const double *draws, std::uint32_t cancelCount,
+                                               std::vector<CompactOrderEvent> &out) {
+    for (std::uint32_t i = 0; i < cancelCount; ++i) {
+        auto order = registry_.takeRandomLive(draws[i]);
         if (!order.has_value()) return;
-        out.emplace_back(EventType::Cancel, order.value().getId());
-        registry_.onCancel(order.value().getId());
+        out.push_back(CompactOrderEvent::Cancel(order.value().getId()));
     }
 }
 
-[[maybe_unused]] void OrderGenerator::generateModifyOrderEvents(double mid, int modifyCount,
-                                                                std::vector<OrderEvent> &out) {
+[[maybe_unused]] void OrderGenerator::generateModifyOrderEvents(double mid, int modifyCount, PhiloxStream &rng,
+                                                                std::vector<CompactOrderEvent> &out) {
     if (modifyCount <= 0) return;
 
     out.reserve(out.size() + static_cast<size_t>(modifyCount));
 
     for (int i = 0; i < modifyCount; ++i) {
-        auto order = registry_.randomLive(rng_);
+        auto order = registry_.randomLive(rng.uniform());
         if (!order.has_value()) return;
 
         Price price = order->getPrice();
         Quantity quantity = order->getRemainingQuantity();
         Side side = order->getSide();
 
-        if (bernoulliDist_(rng_)) {
-            quantity = getRandomQuantity();
+        if (rng.uniform() < 0.5) {
+            quantity = getRandomQuantity(rng);
         }
-        if (bernoulliDist_(rng_)) {
-            side = getRandomSide();
+        if (rng.uniform() < 0.5) {
+            side = getRandomSide(rng);
         }
-        if (bernoulliDist_(rng_)) {
-            price = getRandomOrderPrice(mid, side);
+        if (rng.uniform() < 0.5) {
+            price = getRandomOrderPrice(mid, side, rng);
         }
 
         auto modify{OrderModify{order->getId(), side, price, quantity}};
-        out.emplace_back(
-            EventType::Modify,
-            modify
-        );
+        out.push_back(CompactOrderEvent::Modify(modify));
         registry_.onModify(modify);
     }
-}
\ No newline at end of file
+}
@@ -7,58 +7,93 @@
 
 #include "OrderRegistry.h"
 #include "MarketState.h"
-#include "OrderEvent.h"
+#include "CompactOrderEvent.h"
+#include "shared/Philox.h"
 
-#include <random>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 class OrderGenerator {
 public:
-    std::vector<OrderEvent> generate();
+    static constexpr size_t Unbounded = std::numeric_limits<size_t>::max();
 
-    OrderGenerator(MarketState state, size_t ticks) : state_{state}, ticks_{ticks} {
-    }
+    std::vector<CompactOrderEvent> generate();
+
+    // Appends the next round of ticks to out. Returns false once every tick has been generated.
+    bool generateChunk(std::vector<CompactOrderEvent> &out);
+
+    OrderGenerator(MarketState state, size_t ticks);
+
+    [[nodiscard]] const OrderRegistry &registry() const { return registry_; }
+
+    [[nodiscard]] OrderId issuedIds() const { return nextId_; }
 
 private:
+    // Everything a tick needs that does not depend on the live order set, drawn on a worker thread.
+    struct PendingOrder {
+        OrderType type;
+        Side side;
+        Price price;
+        Quantity quantity;
+    };
+
+    struct TickRange {
+        size_t firstTick{};
+        size_t tickCount{};
+        std::vector<std::uint32_t> cancelCounts;
+        std::vector<std::uint32_t> addCounts;
+        std::vector<double> cancelDraws;
+        std::vector<PendingOrder> adds;
+    };
+
+    // Independent Philox domains, so adding draws to one never shifts another.
+    enum StreamDomain : std::uint32_t {
+        MidPath = 0,
+        TickDraws = 1,
+        Merge = 2
+    };
+
+    static constexpr int eventsPerTick = 10;
+    static constexpr double addOdds = 55.0 / (55.0 + 45.0);
+    static constexpr size_t ticksPerRange = 1 << 14;
+
     OrderId nextId_{0};
     OrderRegistry registry_{};
     MarketState state_{};
     size_t ticks_{};
+    size_t nextTick_{0};
 
-    std::random_device dev_{};
-    std::mt19937 rng_{dev_()};
-    std::normal_distribution<double> normalDist_{0.0, 1.0};
-    std::uniform_real_distribution<double> uniformSpread_{-0.499999999, 0.5};
-    std::uniform_real_distribution<double> uniformZeroToOne_{0, 1};
-    std::bernoulli_distribution bernoulliDist_{0.5};
+    double mid_{};
+    double logDrift_{};
+    double logVol_{};
+    std::vector<double> eventCountCdf_;
+    std::vector<double> mids_;
+    std::vector<TickRange> ranges_;
 
+    void generateMidPath(size_t firstTick, size_t tickCount, std::vector<double> &mids);
 
-    static constexpr int eventsPerTick = 10;
-    static constexpr std::array<double, 2> addCancelModOdds{55.0, 45.0};
-
-    std::poisson_distribution<int> eventCountDist_{eventsPerTick};
-    std::discrete_distribution<int> eventTypeDist_{
-        addCancelModOdds.begin(),
-        addCancelModOdds.end()
-    };
+    void drawTickRange(const double *mids, TickRange &range) const;
 
-    double getRandom() { return normalDist_(rng_); }
+    void mergeTickRange(const TickRange &range, std::vector<CompactOrderEvent> &out);
 
-    double getUSample() { return uniformSpread_(rng_); }
+    void generateAddOrderEvents(const PendingOrder *adds, std::uint32_t addCount, std::vector<CompactOrderEvent> &out);
 
-    Side getRandomSide();
+    void generateCancelOrderEvents(const double *draws, std::uint32_t cancelCount, std::vector<CompactOrderEvent> &out);
 
-    void generateAddOrderEvents(double mid, int addCount, std::vector<OrderEvent> &out);
+    [[maybe_unused]] void generateModifyOrderEvents(double mid, int modifyCount, PhiloxStream &rng,
+                                                    std::vector<CompactOrderEvent> &out);
 
-    void generateCancelOrderEvents(int cancelCount, std::vector<OrderEvent> &out);
+    [[nodiscard]] int getRandomEventCount(PhiloxStream &rng) const;
 
-    [[maybe_unused]] void generateModifyOrderEvents(double mid, int modifyCount, std::vector<OrderEvent> &out);
+    [[nodiscard]] Price getRandomOrderPrice(double mid, Side side, PhiloxStream &rng) const;
 
-    Price getRandomOrderPrice(double mid, Side side);
+    static Side getRandomSide(PhiloxStream &rng);
 
-    Quantity getRandomQuantity();
+    static Quantity getRandomQuantity(PhiloxStream &rng);
 
-    OrderType getRandomOrderType();
+    static OrderType getRandomOrderType(PhiloxStream &rng);
 };
 
-#endif // ORDERBOOK_ORDERGENERATOR_H
\ No newline at end of file
+#endif // ORDERBOOK_ORDERGENERATOR_H
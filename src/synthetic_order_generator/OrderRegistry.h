@@ -5,69 +5,77 @@
 #include "orderbook/OrderModify.h"
 #include <algorithm>
 #include <optional>
-#include <random>
 #include <unordered_map>
 #include <vector>
 
+// Tracks the orders the generator believes are live. Both the orders and the id -> slot index
+// only hold live entries, so the registry stays sized to the live set however many ids were issued.
 class OrderRegistry {
 public:
     void onNew(const Order &o) {
-        auto [it, inserted] = live_.emplace(o.getId(), o);
+        auto [it, inserted] = idToIndex_.try_emplace(o.getId(), live_.size());
         if (!inserted) {
-            it->second = o;
+            live_[it->second] = o;
             return;
         }
 
-        idToIndex_[o.getId()] = ids_.size();
-        ids_.push_back(o.getId());
+        live_.push_back(o);
     }
 
-    void onCancel(OrderId id) { erase(id); }
+    void onCancel(OrderId id) {
+        const auto it = idToIndex_.find(id);
+        if (it == idToIndex_.end()) return;
+        eraseAt(it->second);
+    }
 
     void onModify(const OrderModify &o) {
-        auto it = live_.find(o.getId());
-        if (it == live_.end()) return;
-        it->second = o.toOrder(it->second.getType());
+        const auto it = idToIndex_.find(o.getId());
+        if (it == idToIndex_.end()) return;
+        Order &live = live_[it->second];
+        live = o.toOrder(live.getType());
     }
 
-    [[nodiscard]] bool empty() const { return ids_.empty(); }
+    [[nodiscard]] bool empty() const { return live_.empty(); }
 
-    std::optional<Order> randomLive(std::mt19937 &rng) const {
-        if (ids_.empty()) return std::nullopt;
-        std::uniform_int_distribution<std::size_t> dist(0, ids_.size() - 1);
+    [[nodiscard]] std::size_t size() const { return live_.size(); }
 
-        OrderId id = ids_[dist(rng)];
-        auto it = live_.find(id);
-        if (it == live_.end()) return std::nullopt;
+    // Entries held by the id -> slot index; equal to size() when nothing leaks.
+    [[nodiscard]] std::size_t indexedIds() const { return idToIndex_.size(); }
 
-        return it->second;
+    // Picks a live order from a uniform draw u in [0, 1), so the choice depends only on the draw.
+    [[nodiscard]] std::optional<Order> randomLive(double u) const {
+        if (live_.empty()) return std::nullopt;
+        return live_[indexFor(u)];
     }
 
-private:
-    void erase(OrderId id) {
-        auto liveIt = live_.find(id);
-        if (liveIt == live_.end()) return;
-        live_.erase(liveIt);
+    // randomLive followed by onCancel, without looking the picked order up a second time.
+    std::optional<Order> takeRandomLive(double u) {
+        if (live_.empty()) return std::nullopt;
+        const std::size_t idx = indexFor(u);
+        Order order = live_[idx];
+        eraseAt(idx);
+        return order;
+    }
 
-        auto idxIt = idToIndex_.find(id);
-        if (idxIt == idToIndex_.end()) return;
+private:
+    [[nodiscard]] std::size_t indexFor(double u) const {
+        return std::min(static_cast<std::size_t>(u * static_cast<double>(live_.size())), live_.size() - 1);
+    }
 
-        std::size_t idx = idxIt->second;
-        std::size_t last = ids_.size() - 1;
+    void eraseAt(std::size_t idx) {
+        const std::size_t last = live_.size() - 1;
+        idToIndex_.erase(live_[idx].getId());
 
         if (idx != last) {
-            OrderId lastId = ids_[last];
-            ids_[idx] = lastId;
-            idToIndex_[lastId] = idx;
+            live_[idx] = live_[last];
+            idToIndex_[live_[idx].getId()] = idx;
         }
 
-        ids_.pop_back();
-        idToIndex_.erase(idxIt);
+        live_.pop_back();
     }
 
-    std::unordered_map<OrderId, Order> live_;
-    std::vector<OrderId> ids_;
+    std::vector<Order> live_;
     std::unordered_map<OrderId, std::size_t> idToIndex_;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,116 @@
+#include "ReplayEngine.h"
+#include "OrderExecutor.h"
+#include "shared/Timer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+std::size_t ReplayReport::events() const {
+    std::size_t total = 0;
+    for (const FileReplay &file: files) total += file.events;
+    return total;
+}
+
+double ReplayReport::eventsPerSecond() const {
+    return wallSeconds > 0 ? static_cast<double>(events()) / wallSeconds : 0;
+}
+
+double ReplayReport::replaySeconds() const {
+    double total = 0;
+    for (const FileReplay &file: files) total += file.replaySeconds;
+    return total;
+}
+
+std::optional<std::size_t> ReplayEngine::firstDivergence(const FileReplay &a, const FileReplay &b) {
+    const std::size_t common = std::min(a.checksums.size(), b.checksums.size());
+    for (std::size_t i = 0; i < common; ++i) {
+        if (a.checksums[i] != b.checksums[i]) return a.checksums[i].events;
+    }
+    if (a.checksums.size() != b.checksums.size()) {
+        return (a.checksums.size() > common ? a.checksums : b.checksums)[common].events;
+    }
+    if (a.events != b.events || a.finalHash != b.finalHash) return std::max(a.events, b.events);
+    return std::nullopt;
+}
+
+ReplayEngine::ReplayEngine(std::size_t workers, const MemoryOptions &memory)
+    : pool_{workers}, books_{memory, pool_.workers()} {
+}
+
+std::vector<std::string> ReplayEngine::listFiles(const std::string &directoryOrManifest) {
+    const fs::path path{directoryOrManifest};
+    if (!fs::exists(path)) throw std::runtime_error("Replay path does not exist: " + directoryOrManifest);
+
+    std::vector<std::string> files;
+    if (fs::is_directory(path)) {
+        for (const auto &entry: fs::directory_iterator{path}) {
+            if (entry.is_regular_file()) files.push_back(entry.path().string());
+        }
+        std::ranges::sort(files);
+        return files;
+    }
+
+    std::ifstream manifest{path};
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.front() == '#') continue;
+        const fs::path listed{line};
+        files.push_back((listed.is_absolute() ? listed : path.parent_path() / listed).string());
+    }
+    return files;
+}
+
+ReplayReport ReplayEngine::run(const std::vector<std::string> &files) {
+    // File size stands in for replay cost when ordering the work.
+    std::vector<std::uintmax_t> sizes(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (!fs::is_regular_file(files[i])) throw std::runtime_error("Replay file does not exist: " + files[i]);
+        sizes[i] = fs::file_size(files[i]);
+    }
+    std::vector<std::size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0uz);
+    std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    ReplayReport report;
+    report.files.resize(files.size());
+    report.workers = std::min(pool_.workers(), std::max<std::size_t>(files.size(), 1));
+
+    const Timer wall;
+    pool_.run(files.size(), [&](std::size_t task, std::size_t worker) {
+        const std::size_t index = order[task];
+        FileReplay &result = report.files[index];
+        result.path = files[index];
+        result.worker = worker;
+
+        Timer timer;
+        const std::vector<CompactOrderEvent> events = OrderExecutor::getOrdersFromCsv(files[index]);
+        result.loadSeconds = timer.elapsed();
+        result.events = events.size();
+
+        const BookPool::Lease book = books_.acquire();
+        if (checksumInterval_ != 0) result.checksums.reserve(events.size() / checksumInterval_);
+        timer.start();
+        std::size_t untilChecksum = checksumInterval_;
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            OrderExecutor::apply(*book, events[i]);
+            if (checksumInterval_ != 0 && --untilChecksum == 0) {
+                result.checksums.push_back({i + 1, book->bookHash()});
+                untilChecksum = checksumInterval_;
+            }
+        }
+        result.replaySeconds = timer.elapsed();
+        // bookHash() would switch incremental hashing on for good, and the pooled book would carry
+        // it into the next file's replay; a walk of the final book leaves that to checksumEvery().
+        result.finalHash = checksumInterval_ != 0 ? book->bookHash() : book->recomputeBookHash();
+        result.trades = book->getTrades().size();
+        result.resting = book->size();
+    });
+    report.wallSeconds = wall.elapsed();
+    return report;
+}
@@ -0,0 +1,87 @@
+#ifndef ORDERBOOK_REPLAYENGINE_H
+#define ORDERBOOK_REPLAYENGINE_H
+
+#include "orderbook/BookPool.h"
+#include "shared/WorkStealingPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct ReplayChecksum {
+    // Events applied when the hash was taken.
+    std::size_t events;
+    std::uint64_t bookHash;
+
+    friend bool operator==(const ReplayChecksum &, const ReplayChecksum &) = default;
+};
+
+struct FileReplay {
+    std::string path;
+    std::size_t events{};
+    // Reading and parsing the file, then applying its events to the book.
+    double loadSeconds{};
+    double replaySeconds{};
+    std::size_t trades{};
+    // Orders still resting once the file is done.
+    std::size_t resting{};
+    std::size_t worker{};
+    // Orderbook::bookHash() after the last event, and every checksumEvery() events before it.
+    std::uint64_t finalHash{};
+    std::vector<ReplayChecksum> checksums;
+
+    [[nodiscard]] double eventsPerSecond() const { return replaySeconds > 0 ? events / replaySeconds : 0; }
+};
+
+struct ReplayReport {
+    // In the order the files were given.
+    std::vector<FileReplay> files;
+    std::size_t workers{};
+    double wallSeconds{};
+
+    [[nodiscard]] std::size_t events() const;
+
+    // Events over wall time, loading included: what the whole backtest achieved.
+    [[nodiscard]] double eventsPerSecond() const;
+
+    // Summed per-file replay time, i.e. matching only, across all workers.
+    [[nodiscard]] double replaySeconds() const;
+};
+
+// Replays many event files (the CSV layout OrderExecutor reads) in parallel, one Orderbook per file.
+// Files are scheduled largest first on a WorkStealingPool. Books come from a BookPool, so each
+// worker reuses one warm book, reset between files, instead of constructing one per file.
+class ReplayEngine {
+public:
+    explicit ReplayEngine(std::size_t workers = WorkStealingPool::defaultWorkers(), const MemoryOptions &memory = {});
+
+    // A directory gives every regular file in it, sorted by name. Any other path is read as a
+    // manifest: one file per line, relative to the manifest's directory unless absolute; blank
+    // lines and lines starting with '#' are skipped. Throws if the path does not exist.
+    static std::vector<std::string> listFiles(const std::string &directoryOrManifest);
+
+    // Throws if a listed file does not exist, or rethrows the first failure of a replay.
+    [[nodiscard]] ReplayReport run(const std::vector<std::string> &files);
+
+    [[nodiscard]] ReplayReport run(const std::string &directoryOrManifest) { return run(listFiles(directoryOrManifest)); }
+
+    [[nodiscard]] std::size_t workers() const { return pool_.workers(); }
+
+    // Records the book hash every events events of each file; 0, the default, records only the
+    // final hash. Reading the hash is a load, so a small interval costs little, but the engine's
+    // books keep maintaining it from then on: time plain replays on an engine that never had it.
+    void checksumEvery(std::size_t events) { checksumInterval_ = events; }
+
+    // The event count of the first checksum at which two replays of the same file disagree, or
+    // nullopt if they agree throughout. A replay that stops early diverges where it stops.
+    static std::optional<std::size_t> firstDivergence(const FileReplay &a, const FileReplay &b);
+
+private:
+    WorkStealingPool pool_;
+    std::size_t checksumInterval_{0};
+    BookPool books_;
+};
+
+#endif //ORDERBOOK_REPLAYENGINE_H
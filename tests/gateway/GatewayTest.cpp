@@ -0,0 +1,179 @@
+#include "gateway/Gateway.h"
+#include "gateway/GatewayClient.h"
+#include "../orderbook/TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using Protocol::Request;
+using Protocol::RequestType;
+using Type = ExecutionReport::Type;
+
+namespace {
+    std::string socketPath() {
+        return std::string{"/tmp/orderbook_test_"} +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".sock";
+    }
+
+    // A gateway on an ephemeral TCP port and a Unix socket, run on its own thread.
+    class RunningGateway {
+    public:
+        explicit RunningGateway(GatewayOptions options = {}) {
+            options.unixPath = socketPath();
+            gateway_ = std::make_unique<Gateway>(book_, options);
+            thread_ = std::thread{[this] { gateway_->run(stop_); }};
+        }
+
+        ~RunningGateway() {
+            stop_ = true;
+            thread_.join();
+        }
+
+        Orderbook &book() { return book_; }
+
+        Gateway &gateway() { return *gateway_; }
+
+        GatewayClient tcp() const { return GatewayClient::connectTcp("127.0.0.1", gateway_->tcpPort()); }
+
+        static GatewayClient local() { return GatewayClient::connectUnix(socketPath()); }
+
+    private:
+        Orderbook book_{false};
+        std::unique_ptr<Gateway> gateway_;
+        std::atomic<bool> stop_{false};
+        std::thread thread_;
+    };
+
+    Request newOrder(OrderId clientId, Side side, Price price, Quantity quantity, std::uint64_t timestamp = 0) {
+        return {RequestType::NewOrder, side, OrderType::GoodTillCancel, 0, price, clientId, quantity, timestamp};
+    }
+
+    Protocol::Report next(GatewayClient &client) {
+        Protocol::Report report{};
+        EXPECT_TRUE(client.receive(report, 2s)) << "no report";
+        return report;
+    }
+
+    template<class F>
+    bool eventually(F &&condition) {
+        for (int i = 0; i < 400 && !condition(); ++i) std::this_thread::sleep_for(5ms);
+        return condition();
+    }
+}
+
+TEST(Gateway, AcksAndFillsReachBothSidesOverTcpAndUnix) {
+    RunningGateway running;
+    GatewayClient maker = running.tcp();
+    GatewayClient taker = RunningGateway::local();
+
+    maker.send(newOrder(7, Side::Buy, 100, 10, 111));
+    auto report = next(maker);
+    EXPECT_EQ(report.type, Type::Accepted);
+    EXPECT_EQ(report.clientOrderId, 7u);
+    EXPECT_EQ(report.clientTimestamp, 111u);
+
+    // The taker reuses the maker's client id: ids are per connection.
+    taker.send(newOrder(7, Side::Sell, 100, 4, 222));
+    report = next(taker);
+    EXPECT_EQ(report.type, Type::Accepted);
+    report = next(taker);
+    EXPECT_EQ(report.type, Type::Filled);
+    EXPECT_EQ(report.lastQuantity, 4u);
+    EXPECT_EQ(report.clientTimestamp, 222u);
+
+    report = next(maker);
+    EXPECT_EQ(report.type, Type::PartiallyFilled);
+    EXPECT_EQ(report.clientOrderId, 7u);
+    EXPECT_EQ(report.leavesQuantity, 6u);
+    EXPECT_EQ(report.clientTimestamp, 0u);
+}
+
+TEST(Gateway, CancelModifyAndRejects) {
+    RunningGateway running;
+    GatewayClient client = running.tcp();
+
+    client.send(newOrder(1, Side::Sell, 105, 10));
+    EXPECT_EQ(next(client).type, Type::Accepted);
+
+    client.send(newOrder(1, Side::Sell, 106, 10));
+    auto report = next(client);
+    EXPECT_EQ(report.type, Type::Rejected);
+    EXPECT_EQ(report.reason, static_cast<std::uint8_t>(ExecutionReport::Reason::DuplicateId));
+
+    client.send({RequestType::ModifyOrder, Side::Sell, OrderType::GoodTillCancel, 0, 104, 1, 3, 5});
+    EXPECT_EQ(next(client).type, Type::Replaced);
+    report = next(client);
+    EXPECT_EQ(report.type, Type::Accepted);
+    EXPECT_EQ(report.price, 104);
+    EXPECT_EQ(report.clientTimestamp, 5u);
+
+    client.send({RequestType::CancelOrder, Side::Sell, OrderType::GoodTillCancel, 0, 0, 1, 0, 6});
+    EXPECT_EQ(next(client).type, Type::Cancelled);
+    EXPECT_EQ(running.book().size(), 0u);
+
+    client.send({RequestType::CancelOrder, Side::Sell, OrderType::GoodTillCancel, 0, 0, 1, 0, 7});
+    report = next(client);
+    EXPECT_EQ(report.type, Type::Rejected);
+    EXPECT_EQ(report.reason, Protocol::UnknownOrder);
+
+    client.send({static_cast<RequestType>(9), Side::Buy, OrderType::GoodTillCancel, 0, 100, 2, 1, 8});
+    report = next(client);
+    EXPECT_EQ(report.type, Type::Rejected);
+    EXPECT_EQ(report.reason, Protocol::InvalidRequest);
+}
+
+TEST(Gateway, RequestsSplitAcrossWritesAreReassembled) {
+    RunningGateway running;
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath().c_str());
+    ASSERT_EQ(connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof address), 0);
+
+    Request requests[2] = {newOrder(1, Side::Buy, 99, 5), newOrder(2, Side::Buy, 98, 5)};
+    const auto *bytes = reinterpret_cast<const char *>(requests);
+    ASSERT_EQ(write(fd, bytes, 20), 20);
+    std::this_thread::sleep_for(20ms);
+    ASSERT_EQ(write(fd, bytes + 20, sizeof requests - 20), static_cast<ssize_t>(sizeof requests - 20));
+
+    EXPECT_TRUE(eventually([&] { return running.book().size() == 2; }));
+    close(fd);
+}
+
+TEST(Gateway, DisconnectCancelsTheClientsOrders) {
+    RunningGateway running;
+    GatewayClient stays = running.tcp();
+    {
+        GatewayClient leaves = RunningGateway::local();
+        for (OrderId id = 0; id < 5; ++id) leaves.send(newOrder(id, Side::Buy, 90 + static_cast<Price>(id), 1));
+        for (int i = 0; i < 5; ++i) EXPECT_EQ(next(leaves).type, Type::Accepted);
+    }
+    stays.send(newOrder(1, Side::Sell, 110, 1));
+    EXPECT_EQ(next(stays).type, Type::Accepted);
+
+    EXPECT_TRUE(eventually([&] { return running.gateway().stats().disconnected == 1; }));
+    EXPECT_EQ(running.book().size(), 1u);
+    EXPECT_EQ(running.gateway().stats().accepted, 2u);
+}
+
+TEST(Gateway, IdleClientsHearAboutExpiredOrders) {
+    RunningGateway running;
+    GatewayClient client = running.tcp();
+    client.send({RequestType::NewOrder, Side::Buy, OrderType::GoodForDay, 0, 100, 3, 10, 1});
+    EXPECT_EQ(next(client).type, Type::Accepted);
+
+    // The close-of-day prune runs off the gateway's thread, and no request follows it.
+    PruneTestHelper::pruneStaleGoodForNow(running.book());
+    const auto report = next(client);
+    EXPECT_EQ(report.type, Type::Expired);
+    EXPECT_EQ(report.clientOrderId, 3u);
+    EXPECT_EQ(report.clientTimestamp, 0u);
+}
@@ -0,0 +1,181 @@
+#include "itch/ItchBookBuilder.h"
+#include "itch/ItchReader.h"
+#include "itch/ItchWriter.h"
+#include "shared/MappedFile.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+    // $100.00 and $100.01 in ITCH's four implied decimals, i.e. ticks 10000 and 10001.
+    constexpr std::uint32_t bid = 1'000'000;
+    constexpr std::uint32_t ask = 1'000'100;
+
+    std::vector<LevelInfo> depth(const Orderbook &ob, Side side) { return ob.getDepth(side, 10); }
+}
+
+TEST(Itch, WriterAndReaderRoundTripEveryBookMessage) {
+    ItchWriter writer;
+    writer.setTimestamp(34'200'000'000'123);
+    writer.addOrderWithMpid(7, 42, Side::Sell, 300, "AAPL", ask, "GSCO");
+    writer.orderReplace(7, 42, 43, 200, bid);
+    writer.orderExecutedWithPrice(7, 43, 50, 9, bid);
+
+    ItchReader reader{writer.bytes()};
+    auto message = reader.next();
+    ASSERT_TRUE(message);
+    ASSERT_EQ(message->type(), Itch::MessageType::AddOrderWithMpid);
+    EXPECT_EQ(message->bytes().size(), Itch::sizeOf(Itch::MessageType::AddOrderWithMpid));
+    EXPECT_EQ(message->timestamp(), 34'200'000'000'123u);
+    const Itch::AddOrder add{message->bytes()};
+    EXPECT_EQ(add.locate(), 7);
+    EXPECT_EQ(add.reference(), 42u);
+    EXPECT_EQ(add.side(), Side::Sell);
+    EXPECT_EQ(add.shares(), 300u);
+    EXPECT_EQ(add.stock(), "AAPL");
+    EXPECT_EQ(add.price(), ask);
+
+    message = reader.next();
+    ASSERT_TRUE(message);
+    const Itch::OrderReplace replace{message->bytes()};
+    EXPECT_EQ(replace.originalReference(), 42u);
+    EXPECT_EQ(replace.newReference(), 43u);
+    EXPECT_EQ(replace.shares(), 200u);
+    EXPECT_EQ(replace.price(), bid);
+
+    message = reader.next();
+    ASSERT_TRUE(message);
+    EXPECT_EQ(Itch::OrderExecuted{message->bytes()}.matchNumber(), 9u);
+    EXPECT_FALSE(reader.next());
+    EXPECT_EQ(reader.offset(), writer.bytes().size());
+
+    // A length prefix that runs past the end of the image.
+    const std::span truncated{writer.bytes().data(), writer.bytes().size() - 1};
+    ItchReader short_{truncated};
+    short_.next();
+    short_.next();
+    EXPECT_THROW(short_.next(), std::runtime_error);
+}
+
+TEST(Itch, BuildsOneBookPerLocate) {
+    ItchWriter writer;
+    writer.systemEvent('O');
+    writer.stockDirectory(1, "AAPL");
+    writer.stockDirectory(2, "MSFT");
+    writer.addOrder(1, 1, Side::Buy, 100, "AAPL", bid);
+    writer.addOrder(1, 2, Side::Buy, 50, "AAPL", bid);
+    writer.addOrder(1, 3, Side::Sell, 70, "AAPL", ask);
+    writer.addOrderWithMpid(2, 4, Side::Sell, 10, "MSFT", ask, "MSCO");
+    writer.orderExecuted(1, 1, 30, 1);    // 100 -> 70
+    writer.orderCancel(1, 2, 50);         // all of it
+    writer.orderExecuted(1, 3, 70, 2);    // all of it
+    writer.orderReplace(2, 4, 5, 25, bid);
+    writer.orderDelete(2, 5);
+    writer.addOrder(2, 6, Side::Buy, 5, "MSFT", bid);
+
+    ItchBookBuilder builder;
+    builder.replay(writer.bytes());
+
+    EXPECT_EQ(builder.locates(), (std::vector<std::uint16_t>{1, 2}));
+    EXPECT_EQ(builder.symbol(1), "AAPL");
+    EXPECT_EQ(builder.symbol(2), "MSFT");
+    EXPECT_EQ(builder.book(3), nullptr);
+
+    const Orderbook &aapl = *builder.book(1);
+    ASSERT_EQ(depth(aapl, Side::Buy).size(), 1u);
+    EXPECT_EQ(depth(aapl, Side::Buy)[0].price, 10'000);
+    EXPECT_EQ(depth(aapl, Side::Buy)[0].quantity, 70u);
+    EXPECT_TRUE(depth(aapl, Side::Sell).empty());
+    EXPECT_EQ(aapl.size(), 1u);
+
+    const Orderbook &msft = *builder.book(2);
+    EXPECT_TRUE(depth(msft, Side::Sell).empty());
+    ASSERT_EQ(depth(msft, Side::Buy).size(), 1u);
+    EXPECT_EQ(depth(msft, Side::Buy)[0].quantity, 5u);
+    EXPECT_EQ(builder.resting(), 2u);
+
+    const ItchStats &stats = builder.stats();
+    EXPECT_EQ(stats.messages, 13u);
+    EXPECT_EQ(stats.adds, 5u);
+    EXPECT_EQ(stats.executions, 2u);
+    EXPECT_EQ(stats.cancels, 1u);
+    EXPECT_EQ(stats.replaces, 1u);
+    EXPECT_EQ(stats.deletes, 1u);
+    EXPECT_EQ(stats.skipped, 3u);
+    EXPECT_EQ(stats.unknownOrders + stats.unpriceable + stats.crossed, 0u);
+}
+
+TEST(Itch, FiltersSymbolsAndCountsWhatItCannotApply) {
+    ItchWriter writer;
+    writer.addOrder(1, 1, Side::Buy, 100, "AAPL", bid);
+    writer.addOrder(2, 2, Side::Buy, 100, "MSFT", bid);
+    writer.orderDelete(2, 2);                                // no MSFT book
+    writer.addOrder(1, 3, Side::Buy, 100, "AAPL", bid + 50); // sub-penny
+    writer.addOrder(1, 4, Side::Buy, 100, "AAPL", 60'000 * 100);
+    writer.orderExecuted(1, 3, 100, 1);                      // dropped above
+    writer.orderDelete(1, 99);
+    writer.addOrder(1, 5, Side::Sell, 40, "AAPL", bid);      // crosses order 1: 100 -> 60
+    writer.orderExecuted(1, 1, 50, 2);                       // 60 -> 10, not back up to 50
+
+    ItchBookBuilder builder{{.symbols = {"AAPL"}}};
+    builder.replay(writer.bytes());
+
+    EXPECT_EQ(builder.locates(), (std::vector<std::uint16_t>{1}));
+    const ItchStats &stats = builder.stats();
+    EXPECT_EQ(stats.skipped, 2u);
+    EXPECT_EQ(stats.unpriceable, 2u);
+    EXPECT_EQ(stats.unknownOrders, 2u);
+    EXPECT_EQ(stats.crossed, 1u);
+    EXPECT_EQ(depth(*builder.book(1), Side::Buy)[0].quantity, 10u);
+}
+
+TEST(Itch, PartialExecutionsKeepQueuePriority) {
+    ItchWriter writer;
+    writer.addOrder(1, 1, Side::Buy, 100, "AAPL", bid);
+    writer.addOrder(1, 2, Side::Buy, 100, "AAPL", bid);
+    writer.orderExecuted(1, 1, 30, 1);                  // 100 -> 70, still first
+    writer.addOrder(1, 3, Side::Sell, 70, "AAPL", bid); // fills order 1, not order 2
+    writer.orderDelete(1, 1);
+
+    ItchBookBuilder builder;
+    builder.replay(writer.bytes());
+
+    EXPECT_EQ(builder.stats().unknownOrders, 1u);
+    EXPECT_EQ(depth(*builder.book(1), Side::Buy)[0].quantity, 100u);
+}
+
+TEST(Itch, RejectsAZeroPriceScale) {
+    ItchOptions options;
+    options.priceScale = 0;
+    EXPECT_THROW(ItchBookBuilder{options}, std::invalid_argument);
+}
+
+TEST(Itch, ReplaysFromAMappedFile) {
+    ItchWriter writer;
+    for (std::uint64_t reference = 1; reference <= 200; ++reference) {
+        const bool buy = reference % 2;
+        const std::uint32_t offset = static_cast<std::uint32_t>(reference % 7) * 100;
+        writer.addOrder(1, reference, buy ? Side::Buy : Side::Sell, 100, "AAPL", buy ? bid - offset : ask + offset);
+        if (reference % 3 == 0) writer.orderCancel(1, reference - 1, 10);
+        if (reference % 5 == 0) writer.orderDelete(1, reference - 2);
+    }
+    const auto path = std::filesystem::temp_directory_path() / "orderbook_itch_test.bin";
+    writer.save(path.string());
+
+    ItchBookBuilder fromMemory;
+    fromMemory.replay(writer.bytes());
+    ItchBookBuilder fromFile;
+    {
+        const MappedFile file = MappedFile::open(path.string());
+        EXPECT_EQ(file.size(), writer.bytes().size());
+        fromFile.replay(file.bytes());
+    }
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(fromFile.resting(), fromMemory.resting());
+    EXPECT_EQ(fromFile.book(1)->bookHash(), fromMemory.book(1)->bookHash());
+    EXPECT_THROW(MappedFile::open(path.string()), std::system_error);
+}
@@ -0,0 +1,102 @@
+#include "TestHelpers.h"
+#include "orderbook/AsyncOrderbook.h"
+
+#include <thread>
+
+namespace {
+    struct Seen {
+        SubmitResult first;
+        SubmitResult second;
+        std::thread::id thread;
+    };
+
+    AsyncTask restThenCross(AsyncOrderbook &async, Seen &seen) {
+        seen.first = co_await async.submit({0, OrderType::GoodTillCancel, Side::Sell, 100, 10});
+        seen.second = co_await async.submit({1, OrderType::GoodTillCancel, Side::Buy, 101, 15});
+        seen.thread = std::this_thread::get_id();
+    }
+
+    AsyncTask killAndReject(AsyncOrderbook &async, SubmitResult &killed, SubmitResult &rejected) {
+        killed = co_await async.submit({0, OrderType::FillAndKill, Side::Buy, 100, 5});
+        rejected = co_await async.submit({1, OrderType::GoodTillCancel, Side::Buy, 100, 0});
+    }
+
+    // Quotes both sides around 1000 and lifts whatever it can; every strategy's ids are disjoint.
+    AsyncTask quoter(AsyncOrderbook &async, OrderId firstId, int rounds, Quantity &filled) {
+        for (int i = 0; i < rounds; ++i) {
+            const OrderId id = firstId + static_cast<OrderId>(2 * i);
+            const Price offset = static_cast<Price>(id % 7);
+            const auto bid = co_await async.submit({id, OrderType::GoodTillCancel, Side::Buy, 1000 - offset, 3});
+            const auto ask = co_await async.submit({id + 1, OrderType::GoodTillCancel, Side::Sell, 997 + offset, 3});
+            filled += bid.filled + ask.filled;
+        }
+    }
+}
+
+TEST(AsyncOrderbook, SubmitResolvesWithFillsAndHandle) {
+    Orderbook ob{false};
+    Seen seen;
+    {
+        AsyncOrderbook async{ob};
+        async.spawn(restThenCross(async, seen));
+        async.waitIdle();
+        EXPECT_EQ(2, async.submitted());
+    }
+
+    EXPECT_TRUE(seen.first.resting());
+    EXPECT_EQ(0, seen.first.filled);
+    EXPECT_EQ(ExecutionReport::Type::Accepted, seen.first.last);
+
+    // Takes the 10 resting and rests the remaining 5.
+    EXPECT_EQ(10, seen.second.filled);
+    EXPECT_EQ(1, seen.second.fills);
+    EXPECT_EQ(ExecutionReport::Type::PartiallyFilled, seen.second.last);
+    ASSERT_TRUE(seen.second.resting());
+    EXPECT_TRUE(ob.cancelOrder(seen.second.handle));
+
+    EXPECT_NE(std::this_thread::get_id(), seen.thread);
+    EXPECT_EQ(0, ob.size());
+}
+
+TEST(AsyncOrderbook, SubmitReportsKillsAndRejects) {
+    Orderbook ob{false};
+    SubmitResult killed, rejected;
+    {
+        AsyncOrderbook async{ob};
+        async.spawn(killAndReject(async, killed, rejected));
+        async.waitIdle();
+    }
+
+    EXPECT_FALSE(killed.resting());
+    EXPECT_EQ(ExecutionReport::Type::Killed, killed.last);
+    EXPECT_EQ(ExecutionReport::Reason::NotMarketable, killed.reason);
+    EXPECT_EQ(ExecutionReport::Type::Rejected, rejected.last);
+    EXPECT_EQ(ExecutionReport::Reason::ZeroQuantity, rejected.reason);
+}
+
+TEST(AsyncOrderbook, ThousandsOfStrategiesShareOneExecutor) {
+    constexpr int strategies = 2000;
+    constexpr int rounds = 10;
+    Orderbook ob{false};
+    std::vector<Quantity> filled(strategies, 0);
+    AsyncOrderbook async{ob};
+    for (int s = 0; s < strategies; ++s) {
+        async.spawn(quoter(async, static_cast<OrderId>(s) * 2 * rounds, rounds, filled[s]));
+    }
+    async.waitIdle();
+    EXPECT_EQ(0, async.liveTasks());
+    EXPECT_EQ(static_cast<std::size_t>(strategies * rounds * 2), async.submitted());
+
+    // A submit only sees its own order's fills as the aggressor, and whatever did not trade rests.
+    Quantity traded = 0;
+    for (const Trade &trade: ob.getTrades()) traded += trade.getQuantity();
+    Quantity total = 0;
+    for (const Quantity q: filled) total += q;
+    EXPECT_EQ(traded, total);
+
+    Quantity resting = 0;
+    const auto infos = ob.getOrderInfos();
+    for (const auto &level: infos.getBids()) resting += level.quantity;
+    for (const auto &level: infos.getAsks()) resting += level.quantity;
+    EXPECT_EQ(static_cast<Quantity>(strategies * rounds * 2 * 3), resting + 2 * traded);
+}
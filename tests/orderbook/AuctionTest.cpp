@@ -0,0 +1,70 @@
+#include "TestHelpers.h"
+
+TEST(Auction, OrdersRestCrossedUntilUncross) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.openAuction();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 105, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 95, 10));
+    ob.addOrder(f.make(OrderType::FillAndKill, Side::Buy, 110, 5));
+    ob.addOrder(f.make(OrderType::FillOrKill, Side::Sell, 90, 5));
+
+    EXPECT_TRUE(ob.inAuction());
+    EXPECT_TRUE(ob.getTrades().empty());
+    EXPECT_EQ(2, ob.size());
+}
+
+TEST(Auction, UncrossesAtVolumeMaximizingPrice) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.openAuction();
+    // Demand: 10 @ 102, 10 @ 101, 10 @ 100. Supply: 5 @ 99, 10 @ 100, 20 @ 101.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 102, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 99, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 20));
+
+    // At 100: demand 30, supply 15. At 101: demand 20, supply 35. 101 executes 20.
+    EXPECT_EQ(101, ob.indicativeUncross()->price);
+    EXPECT_TRUE(ob.getTrades().empty());
+
+    const auto result = ob.uncross();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(101, result->price);
+    EXPECT_EQ(20, result->volume);
+    EXPECT_EQ(15, result->surplus);
+    EXPECT_FALSE(ob.inAuction());
+
+    Quantity traded = 0;
+    for (const auto &trade: ob.getTrades()) {
+        EXPECT_EQ(101, trade.getBidPrice());
+        EXPECT_EQ(101, trade.getAskPrice());
+        traded += trade.getQuantity();
+    }
+    EXPECT_EQ(20, traded);
+
+    // Asks fill in price priority; the book is left uncrossed.
+    const auto infos = ob.getOrderInfos();
+    ASSERT_EQ(1, infos.getBids().size());
+    EXPECT_EQ(100, infos.getBids()[0].price);
+    ASSERT_EQ(1, infos.getAsks().size());
+    EXPECT_EQ(101, infos.getAsks()[0].price);
+    EXPECT_EQ(15, infos.getAsks()[0].quantity);
+    EXPECT_EQ(101, ob.getLastTradePrice());
+
+    // Continuous matching resumes.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 5));
+    EXPECT_EQ(10, ob.getOrderInfos().getAsks()[0].quantity);
+}
+
+TEST(Auction, UncrossWithoutCrossReturnsToContinuous) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.openAuction();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 10));
+    EXPECT_FALSE(ob.uncross().has_value());
+    EXPECT_FALSE(ob.inAuction());
+}
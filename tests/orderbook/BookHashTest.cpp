@@ -0,0 +1,66 @@
+#include "TestHelpers.h"
+
+TEST(BookHash, EmptyBookHashesToZero) {
+    OrderFactory f;
+    Orderbook ob{false};
+    EXPECT_EQ(0, ob.bookHash());
+
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 10));
+    EXPECT_NE(0, ob.bookHash());
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 10));
+    ob.cancelOrder(OrderId{1});
+    EXPECT_EQ(0, ob.bookHash());
+
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ob.reset();
+    EXPECT_EQ(0, ob.bookHash());
+}
+
+TEST(BookHash, SameStateSameHashWhateverTheHistory) {
+    Orderbook direct{false};
+    direct.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 10});
+    direct.addOrder({3, OrderType::GoodTillCancel, Side::Buy, 100, 6});
+
+    // Order 2 is cancelled, order 1 partially filled from 15 down to 10, order 9 fully filled.
+    Orderbook replayed{false};
+    replayed.addOrder({9, OrderType::GoodTillCancel, Side::Buy, 101, 4});
+    replayed.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 15});
+    replayed.addOrder({2, OrderType::GoodTillCancel, Side::Buy, 100, 7});
+    replayed.addOrder({3, OrderType::GoodTillCancel, Side::Buy, 100, 6});
+    replayed.cancelOrder(OrderId{2});
+    replayed.addOrder({4, OrderType::FillAndKill, Side::Sell, 100, 9});
+
+    EXPECT_EQ(direct.bookHash(), replayed.bookHash());
+}
+
+TEST(BookHash, QueuePositionAndQuantityMatter) {
+    Orderbook ab{false};
+    ab.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 100, 5});
+    ab.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 100, 5});
+
+    Orderbook ba{false};
+    ba.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 100, 5});
+    ba.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 100, 5});
+    EXPECT_NE(ab.bookHash(), ba.bookHash());
+    EXPECT_EQ(ab.getOrderInfos().getAsks()[0].quantity, ba.getOrderInfos().getAsks()[0].quantity);
+
+    // Same level totals, split differently.
+    Orderbook split{false};
+    split.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 100, 4});
+    split.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 100, 6});
+    EXPECT_NE(ab.bookHash(), split.bookHash());
+}
+
+// Every path that changes a resting order keeps the incremental hash equal to a full recompute.
+TEST(BookHash, IncrementalMatchesRecomputeUnderRandomFlow) {
+    Orderbook ob{false};
+    RandomFlow flow{17};
+    for (int step = 0; step < 20'000; ++step) {
+        flow.step(ob);
+        if (step % 97 == 0) {
+            ASSERT_EQ(ob.recomputeBookHash(), ob.bookHash()) << "step " << step;
+        }
+    }
+    EXPECT_EQ(ob.recomputeBookHash(), ob.bookHash());
+}
@@ -0,0 +1,79 @@
+#include "TestHelpers.h"
+#include "orderbook/L2BookBuilder.h"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+    void pullInto(ConflatingConsumer &consumer, L2BookBuilder &builder) {
+        std::vector<LevelUpdate> updates;
+        consumer.pull(updates);
+        // Conflated updates skip sequences by design, so only the level states matter here.
+        for (const auto &u: updates) builder.apply(u);
+    }
+}
+
+TEST(Conflation, RepeatedChangesToOneLevel_PullAsLatestValue) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto consumer = ob.subscribeConflated();
+
+    for (int i = 0; i < 50; ++i) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 2));
+    }
+    ob.cancelOrder(0);
+
+    std::vector<LevelUpdate> updates;
+    EXPECT_EQ(1, consumer.pull(updates));
+    ASSERT_EQ(1, updates.size());
+    EXPECT_EQ(100, updates[0].price);
+    EXPECT_EQ(98, updates[0].quantity);
+    EXPECT_EQ(49, updates[0].count);
+
+    updates.clear();
+    EXPECT_EQ(0, consumer.pull(updates));
+}
+
+TEST(Conflation, LappedConsumer_ResyncsFromLevelImage) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 500, 3));
+    auto consumer = ob.subscribeConflated();
+
+    for (int i = 0; i < static_cast<int>(Constants::CONFLATION_LOG_CAPACITY) + 100; ++i) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100 + i % 300, 1));
+    }
+    ob.cancelOrder(0);
+
+    L2BookBuilder builder;
+    pullInto(consumer, builder);
+    EXPECT_EQ(1, consumer.resyncs());
+    expectSameDepth(builder, ob);
+}
+
+TEST(Conflation, ConcurrentSlowConsumer_ConvergesToBook) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto consumer = ob.subscribeConflated();
+    L2BookBuilder builder;
+
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        while (!done.load()) {
+            pullInto(consumer, builder);
+            std::this_thread::yield();
+        }
+    });
+
+    for (int i = 0; i < 50'000; ++i) {
+        const Side side = (i % 2) ? Side::Buy : Side::Sell;
+        const Price price = side == Side::Buy ? 100 + i % 50 : 151 + i % 50;
+        ob.addOrder(f.make(OrderType::GoodTillCancel, side, price, 1 + i % 7));
+        if (i % 3 == 0) ob.cancelOrder(i / 2);
+    }
+    done = true;
+    reader.join();
+
+    pullInto(consumer, builder);
+    expectSameDepth(builder, ob);
+}
@@ -0,0 +1,142 @@
+#include "TestHelpers.h"
+#include "orderbook/LevelKernels.h"
+
+#include <numeric>
+
+namespace {
+    std::vector<LevelKernels::Isa> supportedIsas() {
+        std::vector<LevelKernels::Isa> isas;
+        for (const auto isa: {LevelKernels::Isa::Scalar, LevelKernels::Isa::Avx2, LevelKernels::Isa::Avx512}) {
+            if (LevelKernels::supported(isa)) isas.push_back(isa);
+        }
+        return isas;
+    }
+
+    // Mostly empty levels with odd lengths, so the vector loops and their scalar tails both run.
+    std::vector<Quantity> sparseLevels(std::size_t n) {
+        std::vector<Quantity> values(n);
+        for (std::size_t i = 0; i < n; ++i) values[i] = (i * 7919) % 13 < 3 ? (i * 31) % 100 + 1 : 0;
+        return values;
+    }
+}
+
+TEST(LevelKernels, PrefixSumAndSumAgree) {
+    for (const std::size_t n: {0u, 3u, 8u, 1'003u}) {
+        const auto in = sparseLevels(n);
+        std::vector<Quantity> expected(n);
+        std::inclusive_scan(in.begin(), in.end(), expected.begin());
+        const Quantity total = std::accumulate(in.begin(), in.end(), Quantity{0});
+
+        for (const auto isa: supportedIsas()) {
+            const auto &kernels = LevelKernels::kernels(isa);
+            std::vector<Quantity> out(n);
+            kernels.inclusivePrefixSum(in.data(), out.data(), n);
+            EXPECT_EQ(expected, out) << LevelKernels::name(isa);
+            EXPECT_EQ(total, kernels.sum(in.data(), n)) << LevelKernels::name(isa);
+
+            auto inPlace = in;
+            kernels.inclusivePrefixSum(inPlace.data(), inPlace.data(), n);
+            EXPECT_EQ(expected, inPlace) << LevelKernels::name(isa);
+        }
+    }
+}
+
+TEST(LevelKernels, CumulativeSearchesAgree) {
+    const auto values = sparseLevels(1'003);
+    const auto &scalar = LevelKernels::kernels(LevelKernels::Isa::Scalar);
+    const Quantity total = scalar.sum(values.data(), values.size());
+
+    for (const auto isa: supportedIsas()) {
+        const auto &kernels = LevelKernels::kernels(isa);
+        for (const Quantity target: {Quantity{0}, Quantity{1}, Quantity{500}, total / 2, total, total + 1}) {
+            EXPECT_EQ(scalar.firstCumulativeAtLeast(values.data(), values.size(), target),
+                      kernels.firstCumulativeAtLeast(values.data(), values.size(), target))
+                << LevelKernels::name(isa) << " target " << target;
+            EXPECT_EQ(scalar.lastCumulativeAtLeast(values.data(), values.size(), target),
+                      kernels.lastCumulativeAtLeast(values.data(), values.size(), target))
+                << LevelKernels::name(isa) << " target " << target;
+        }
+        EXPECT_EQ(values.size(), kernels.firstCumulativeAtLeast(values.data(), values.size(), total + 1));
+    }
+}
+
+TEST(LevelKernels, NonZeroScansAgree) {
+    const auto values = sparseLevels(1'003);
+    const auto &scalar = LevelKernels::kernels(LevelKernels::Isa::Scalar);
+
+    for (const auto isa: supportedIsas()) {
+        const auto &kernels = LevelKernels::kernels(isa);
+        for (const std::size_t limit: {0u, 1u, 5u, 64u, 2'000u}) {
+            std::vector<std::uint32_t> expected(limit), actual(limit);
+            const std::size_t want = scalar.firstNonZero(values.data(), values.size(), limit, expected.data());
+            ASSERT_EQ(want, kernels.firstNonZero(values.data(), values.size(), limit, actual.data()));
+            EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + want, actual.begin()))
+                << LevelKernels::name(isa) << " limit " << limit;
+
+            const std::size_t wantBack = scalar.lastNonZero(values.data(), values.size(), limit, expected.data());
+            ASSERT_EQ(wantBack, kernels.lastNonZero(values.data(), values.size(), limit, actual.data()));
+            EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + wantBack, actual.begin()))
+                << LevelKernels::name(isa) << " limit " << limit;
+        }
+    }
+}
+
+TEST(DepthQuery, QuantityThroughSumsFromBest) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 104, 20));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 7));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 95, 3));
+
+    EXPECT_EQ(0, ob.quantityThrough(Side::Sell, 100));
+    EXPECT_EQ(15, ob.quantityThrough(Side::Sell, 103));
+    EXPECT_EQ(35, ob.quantityThrough(Side::Sell, 500));
+    EXPECT_EQ(0, ob.quantityThrough(Side::Buy, 100));
+    EXPECT_EQ(7, ob.quantityThrough(Side::Buy, 96));
+    EXPECT_EQ(10, ob.quantityThrough(Side::Buy, 0));
+}
+
+TEST(DepthQuery, PriceReachingFindsFirstSufficientLevel) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 104, 20));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 7));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 95, 3));
+
+    EXPECT_EQ(101, ob.priceReaching(Side::Sell, 10));
+    EXPECT_EQ(104, ob.priceReaching(Side::Sell, 11));
+    EXPECT_FALSE(ob.priceReaching(Side::Sell, 31).has_value());
+    EXPECT_EQ(99, ob.priceReaching(Side::Buy, 7));
+    EXPECT_EQ(95, ob.priceReaching(Side::Buy, 10));
+    EXPECT_FALSE(ob.priceReaching(Side::Buy, 11).has_value());
+}
+
+TEST(DepthQuery, GetDepthSkipsEmptyLevelsBestFirst) {
+    OrderFactory f;
+    Orderbook ob{false};
+    for (Price price = 100; price < 300; price += 2) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, price, 1));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, price + 1'000, 2));
+    }
+    ob.cancelOrder(f.id - 1); // the ask at 1298
+
+    const auto bids = ob.getDepth(Side::Buy, 3);
+    ASSERT_EQ(3, bids.size());
+    EXPECT_EQ(298, bids[0].price);
+    EXPECT_EQ(296, bids[1].price);
+    EXPECT_EQ(294, bids[2].price);
+
+    const auto asks = ob.getDepth(Side::Sell, 150);
+    ASSERT_EQ(99, asks.size());
+    EXPECT_EQ(1'100, asks.front().price);
+    EXPECT_EQ(1'296, asks.back().price);
+    EXPECT_EQ(2, asks.front().quantity);
+
+    const auto allBids = ob.getDepth(Side::Buy, 1'000);
+    const auto snapshotBids = ob.getOrderInfos().getBids();
+    ASSERT_EQ(snapshotBids.size(), allBids.size());
+    for (std::size_t i = 0; i < allBids.size(); ++i) EXPECT_EQ(snapshotBids[i].price, allBids[i].price);
+}
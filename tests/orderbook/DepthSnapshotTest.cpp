@@ -0,0 +1,105 @@
+#include "TestHelpers.h"
+
+#include <atomic>
+#include <thread>
+
+class SnapshotTestHelper {
+public:
+    static std::mutex &bookLock(Orderbook &ob) { return ob.orderMutex_; }
+};
+
+TEST(DepthSnapshot, MatchesBookAfterEachCall) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 7));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 105, 3));
+
+    auto snapshot = ob.getDepthSnapshot();
+    ASSERT_EQ(2, snapshot->levels.getBids().size());
+    EXPECT_EQ(100, snapshot->levels.getBids()[0].price);
+    EXPECT_EQ(99, snapshot->levels.getBids()[1].price);
+    ASSERT_EQ(1, snapshot->levels.getAsks().size());
+
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 2));
+    ob.cancelOrder(2);
+
+    const auto next = ob.getDepthSnapshot();
+    ASSERT_EQ(2, next->levels.getBids().size());
+    EXPECT_EQ(101, next->levels.getBids()[0].price);
+    EXPECT_EQ(2, next->levels.getBids()[0].quantity);
+    EXPECT_EQ(99, next->levels.getBids()[1].price);
+    EXPECT_TRUE(next->levels.getAsks().empty());
+
+    // The earlier snapshot is immutable.
+    EXPECT_EQ(100, snapshot->levels.getBids()[0].price);
+    EXPECT_GT(next->version, snapshot->version);
+}
+
+TEST(DepthSnapshot, UnchangedBook_ReusesSnapshot) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+
+    const auto first = ob.getDepthSnapshot();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 0, 0));
+    EXPECT_EQ(first, ob.getDepthSnapshot());
+    EXPECT_EQ(1, ob.getSnapshotMetrics().publishes);
+}
+
+TEST(DepthSnapshot, BusyBook_ReturnsPreviousSnapshotWithoutBlocking) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+    const auto before = ob.getDepthSnapshot();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 5));
+
+    {
+        std::scoped_lock _{SnapshotTestHelper::bookLock(ob)};
+        std::shared_ptr<const DepthSnapshot> seen;
+        std::thread reader([&] { seen = ob.getDepthSnapshot(); });
+        reader.join();
+        EXPECT_EQ(before, seen);
+    }
+    EXPECT_EQ(1, ob.getSnapshotMetrics().staleReads);
+
+    // The pending request is served by the next call that changes the book.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 200, 1));
+    const auto metrics = ob.getSnapshotMetrics();
+    EXPECT_EQ(2, metrics.publishes);
+    EXPECT_EQ(3, ob.getDepthSnapshot()->levels.getBids().size() + ob.getDepthSnapshot()->levels.getAsks().size());
+}
+
+TEST(DepthSnapshot, ConcurrentReaders_SeeSortedUncrossedDepth) {
+    OrderFactory f;
+    Orderbook ob{false};
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            const auto snapshot = ob.getDepthSnapshot();
+            const auto &bids = snapshot->levels.getBids();
+            const auto &asks = snapshot->levels.getAsks();
+            const bool sorted =
+                    std::ranges::is_sorted(bids, std::greater{}, &LevelInfo::price) &&
+                    std::ranges::is_sorted(asks, std::less{}, &LevelInfo::price);
+            if (!sorted || (!bids.empty() && !asks.empty() && bids.front().price >= asks.front().price)) ++bad;
+        }
+    });
+
+    for (int i = 0; i < 50'000; ++i) {
+        const Side side = (i % 2) ? Side::Buy : Side::Sell;
+        const Price price = side == Side::Buy ? 100 + i % 60 : 140 + i % 60;
+        ob.addOrder(f.make(OrderType::GoodTillCancel, side, price, 1 + i % 7));
+        if (i % 3 == 0) ob.cancelOrder(i / 2);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(0, bad.load());
+    const auto metrics = ob.getSnapshotMetrics();
+    EXPECT_GT(metrics.reads, 0);
+    EXPECT_GE(metrics.readerMaxNs, metrics.readerAverageNs);
+}
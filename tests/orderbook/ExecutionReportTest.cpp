@@ -0,0 +1,111 @@
+#include "TestHelpers.h"
+
+namespace {
+    using Type = ExecutionReport::Type;
+    using Reason = ExecutionReport::Reason;
+
+    std::vector<ExecutionReport> drain(ExecutionFeed &feed) {
+        std::vector<ExecutionReport> reports;
+        feed.poll([&](const ExecutionReport &r) { reports.push_back(r); });
+        return reports;
+    }
+}
+
+TEST(ExecutionReports, PartialThenFullFill) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &feed = ob.subscribeExecutions();
+
+    ob.addOrder(f.make(0, OrderType::GoodTillCancel, Side::Sell, 100, 10));
+    ob.addOrder(f.make(1, OrderType::GoodTillCancel, Side::Buy, 100, 4));
+    ob.addOrder(f.make(2, OrderType::GoodTillCancel, Side::Buy, 100, 6));
+
+    const auto reports = drain(feed);
+    ASSERT_EQ(7, reports.size());
+
+    EXPECT_EQ(Type::Accepted, reports[0].type);
+    EXPECT_EQ(Type::Accepted, reports[1].type);
+
+    EXPECT_EQ(Type::Filled, reports[2].type);
+    EXPECT_EQ(1, reports[2].orderId);
+    EXPECT_EQ(0, reports[2].counterpartyId);
+    EXPECT_EQ(4, reports[2].lastQuantity);
+
+    EXPECT_EQ(Type::PartiallyFilled, reports[3].type);
+    EXPECT_EQ(0, reports[3].orderId);
+    EXPECT_EQ(6, reports[3].leavesQuantity);
+
+    EXPECT_EQ(Type::Accepted, reports[4].type);
+    EXPECT_EQ(Type::Filled, reports[5].type);
+    EXPECT_EQ(Type::Filled, reports[6].type);
+    EXPECT_EQ(0, reports[6].leavesQuantity);
+
+    for (std::size_t i = 0; i < reports.size(); ++i) EXPECT_EQ(i + 1, reports[i].sequence);
+}
+
+TEST(ExecutionReports, RejectionsAreReportedWithReason) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &feed = ob.subscribeExecutions();
+
+    ob.addOrder(f.make(0, OrderType::GoodTillCancel, Side::Sell, 100, 5));
+    ob.addOrder(f.make(0, OrderType::GoodTillCancel, Side::Sell, 101, 5));
+    ob.addOrder(f.make(1, OrderType::GoodTillCancel, Side::Buy, 90, 0));
+    ob.addOrder(f.make(2, OrderType::GoodTillCancel, Side::Buy, -5, 1));
+    ob.addOrder(f.make(3, OrderType::GoodTillCancel, Side::Buy,
+                       static_cast<Price>(Constants::LEVELARRAY_SIZE), 1));
+    ob.addOrder(f.make(4, OrderType::FillAndKill, Side::Buy, 99, 1));
+    ob.addOrder(f.make(5, OrderType::FillOrKill, Side::Buy, 100, 6));
+    ob.addOrder(f.make(6, Side::Sell, 1));
+
+    const auto reports = drain(feed);
+    ASSERT_EQ(8, reports.size());
+    EXPECT_EQ(Type::Accepted, reports[0].type);
+
+    const std::vector<std::pair<Type, Reason> > expected{
+        {Type::Rejected, Reason::DuplicateId},
+        {Type::Rejected, Reason::ZeroQuantity},
+        {Type::Rejected, Reason::PriceOutOfRange},
+        {Type::Rejected, Reason::PriceOutOfRange},
+        {Type::Killed, Reason::NotMarketable},
+        {Type::Killed, Reason::NotFullyFillable},
+        {Type::Killed, Reason::NoLiquidity},
+    };
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].first, reports[i + 1].type) << i;
+        EXPECT_EQ(expected[i].second, reports[i + 1].reason) << i;
+    }
+    EXPECT_EQ(1, ob.size());
+}
+
+TEST(ExecutionReports, CancelReplaceKillAndExpiry) {
+    OrderFactory f;
+    Orderbook ob{false};
+
+    ob.addOrder(f.make(0, OrderType::GoodTillCancel, Side::Sell, 100, 5));
+    ob.addOrder(f.make(1, OrderType::GoodForDay, Side::Buy, 90, 5));
+    ob.addOrder(f.make(2, OrderType::GoodTillCancel, Side::Buy, 80, 5));
+    auto &feed = ob.subscribeExecutions();
+
+    ob.modifyOrder({2, Side::Buy, 85, 5});
+    ob.cancelOrder(2);
+    ob.addOrder(f.make(3, OrderType::FillAndKill, Side::Buy, 100, 8));
+    PruneTestHelper::pruneStaleGoodForNow(ob);
+
+    const auto reports = drain(feed);
+    ASSERT_EQ(8, reports.size());
+    EXPECT_EQ(Type::Replaced, reports[0].type);
+    EXPECT_EQ(Type::Accepted, reports[1].type);
+    EXPECT_EQ(85, reports[1].price);
+    EXPECT_EQ(Type::Cancelled, reports[2].type);
+
+    EXPECT_EQ(Type::Accepted, reports[3].type);
+    EXPECT_EQ(Type::PartiallyFilled, reports[4].type);
+    EXPECT_EQ(Type::Filled, reports[5].type);
+    EXPECT_EQ(Type::Killed, reports[6].type);
+    EXPECT_EQ(3, reports[6].orderId);
+    EXPECT_EQ(3, reports[6].leavesQuantity);
+
+    EXPECT_EQ(Type::Expired, reports[7].type);
+    EXPECT_EQ(1, reports[7].orderId);
+}
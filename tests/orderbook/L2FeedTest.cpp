@@ -0,0 +1,91 @@
+#include "TestHelpers.h"
+#include "orderbook/L2BookBuilder.h"
+
+namespace {
+    std::vector<LevelUpdate> drain(L2Feed &feed) {
+        std::vector<LevelUpdate> updates;
+        feed.poll([&](const LevelUpdate &u) { updates.push_back(u); });
+        return updates;
+    }
+}
+
+TEST(L2Feed, Subscribe_PublishesExistingDepth) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 98, 7));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 3));
+
+    auto &feed = ob.subscribeL2();
+    L2BookBuilder builder;
+    for (const auto &u: drain(feed)) EXPECT_TRUE(builder.apply(u));
+
+    expectSameDepth(builder, ob);
+    EXPECT_EQ(3, builder.lastSequence());
+}
+
+TEST(L2Feed, Sweep_EmitsOneUpdatePerLevel) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &feed = ob.subscribeL2();
+
+    for (Price p = 100; p < 103; ++p) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, p, 5));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, p, 5));
+    }
+    EXPECT_EQ(6, drain(feed).size());
+
+    // Fully consumes 100 and 101, partially 102; the FAK itself never rests.
+    ob.addOrder(f.make(OrderType::FillAndKill, Side::Buy, 102, 25));
+    const auto updates = drain(feed);
+
+    ASSERT_EQ(4, updates.size());
+    for (const auto &u: updates) {
+        if (u.side == Side::Buy) {
+            EXPECT_EQ(102, u.price);
+            EXPECT_EQ(0, u.count);
+        } else if (u.price == 102) {
+            EXPECT_EQ(5, u.quantity);
+            EXPECT_EQ(1, u.count);
+        } else {
+            EXPECT_EQ(0, u.count);
+        }
+    }
+}
+
+TEST(L2Feed, BuilderTracksBookThroughMixedFlow) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &feed = ob.subscribeL2();
+    L2BookBuilder builder;
+
+    for (int i = 0; i < 200; ++i) {
+        const Side side = (i % 3 == 0) ? Side::Sell : Side::Buy;
+        const Price price = 100 + (i * 7) % 11 - 5;
+        ob.addOrder(f.make(OrderType::GoodTillCancel, side, price, 1 + i % 9));
+        if (i % 5 == 0) ob.cancelOrder(i / 2);
+        if (i % 17 == 0) ob.modifyOrder({static_cast<OrderId>(i / 3), Side::Sell, price + 2, 4});
+    }
+
+    for (const auto &u: drain(feed)) EXPECT_TRUE(builder.apply(u));
+    EXPECT_FALSE(builder.hasGap());
+    expectSameDepth(builder, ob);
+}
+
+TEST(L2Feed, FullRing_DropsAndSurfacesAsGap) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &feed = ob.subscribeL2(4);
+
+    for (Price p = 100; p < 110; ++p) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, p, 1));
+    }
+    EXPECT_EQ(6, feed.dropped());
+
+    L2BookBuilder builder;
+    for (const auto &u: drain(feed)) builder.apply(u);
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 50, 1));
+    for (const auto &u: drain(feed)) builder.apply(u);
+
+    EXPECT_TRUE(builder.hasGap());
+}
@@ -0,0 +1,144 @@
+#include "TestHelpers.h"
+#include "orderbook/MarketDataReader.h"
+#include "shared/Philox.h"
+
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace {
+    void expectQuoteMatches(const Orderbook &ob, const MarketDataReader &reader, std::size_t symbol) {
+        Quote quote{};
+        ASSERT_GT(reader.read(symbol, quote), 0u);
+        const auto bids = ob.getDepth(Side::Buy, Quote::Depth);
+        const auto asks = ob.getDepth(Side::Sell, Quote::Depth);
+        ASSERT_EQ(quote.bidLevels, bids.size());
+        ASSERT_EQ(quote.askLevels, asks.size());
+        for (std::size_t i = 0; i < bids.size(); ++i) {
+            EXPECT_EQ(quote.bids[i].price, bids[i].price);
+            EXPECT_EQ(quote.bids[i].quantity, bids[i].quantity);
+        }
+        for (std::size_t i = 0; i < asks.size(); ++i) {
+            EXPECT_EQ(quote.asks[i].price, asks[i].price);
+            EXPECT_EQ(quote.asks[i].quantity, asks[i].quantity);
+        }
+    }
+}
+
+TEST(MarketData, ReaderSeesEachBooksDepth) {
+    const auto segment = MarketDataSegment::create(sharedMemoryName(), 2);
+    Orderbook first{false};
+    Orderbook second{false};
+    first.publishMarketData(segment, 0);
+    second.publishMarketData(segment, 1);
+    const MarketDataReader reader{sharedMemoryName()};
+    ASSERT_EQ(reader.symbols(), 2u);
+
+    PhiloxStream rng{7, 0, 0};
+    OrderId nextId = 0;
+    for (int step = 0; step < 3000; ++step) {
+        Orderbook &ob = step % 2 == 0 ? first : second;
+        const auto side = rng.below(2) == 0 ? Side::Buy : Side::Sell;
+        // Wide enough that each side usually holds more levels than the quote.
+        const auto price = static_cast<Price>(side == Side::Buy ? 80 + rng.below(22) : 99 + rng.below(22));
+        switch (rng.below(6)) {
+            case 0: ob.cancelOrder(static_cast<OrderId>(rng.below(nextId + 1)));
+                break;
+            case 1: ob.modifyOrder({static_cast<OrderId>(rng.below(nextId + 1)), side, price, 1 + rng.below(9)});
+                break;
+            default: ob.addOrder({nextId++, OrderType::GoodTillCancel, side, price, 1 + rng.below(9)});
+        }
+        expectQuoteMatches(ob, reader, step % 2);
+    }
+}
+
+TEST(MarketData, ChangesBelowThePublishedDepthDoNotRepublish) {
+    const auto segment = MarketDataSegment::create(sharedMemoryName(), 1);
+    Orderbook ob{false};
+    ob.publishMarketData(segment, 0);
+    const MarketDataReader reader{sharedMemoryName()};
+
+    for (OrderId id = 0; id < Quote::Depth + 2; ++id) {
+        ob.addOrder({id, OrderType::GoodTillCancel, Side::Buy, static_cast<Price>(100 - id), 5});
+    }
+    const std::uint64_t before = reader.sequence(0);
+
+    ob.addOrder({100, OrderType::GoodTillCancel, Side::Buy, static_cast<Price>(100 - Quote::Depth), 5});
+    ob.cancelOrder(Quote::Depth + 1);
+    EXPECT_EQ(reader.sequence(0), before);
+
+    std::uint64_t last = before;
+    Quote quote{};
+    EXPECT_FALSE(reader.poll(0, last, quote));
+    ob.addOrder({101, OrderType::GoodTillCancel, Side::Buy, 100, 5});
+    ASSERT_TRUE(reader.poll(0, last, quote));
+    EXPECT_EQ(last, before + 1);
+    EXPECT_EQ(quote.bestBid()->quantity, 10u);
+    EXPECT_EQ(quote.bestBid()->count, 2u);
+    EXPECT_FALSE(quote.bestAsk());
+
+    // Removing a quoted level brings the next one into view.
+    ob.cancelOrder(0);
+    ob.cancelOrder(101);
+    expectQuoteMatches(ob, reader, 0);
+}
+
+TEST(MarketData, ResetPublishesTheEmptyBookAndDetaches) {
+    const auto segment = MarketDataSegment::create(sharedMemoryName(), 1);
+    Orderbook ob{false};
+    ob.publishMarketData(segment, 0);
+    const MarketDataReader reader{sharedMemoryName()};
+
+    ob.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 101, 5});
+    ob.reset();
+    Quote quote{};
+    const std::uint64_t sequence = reader.read(0, quote);
+    EXPECT_EQ(quote.bidLevels + quote.askLevels, 0u);
+
+    ob.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 101, 5});
+    EXPECT_EQ(reader.sequence(0), sequence);
+}
+
+TEST(MarketData, RejectsUnknownSegmentsAndSymbols) {
+    EXPECT_THROW(MarketDataReader{"/orderbook_test_missing_segment"}, std::system_error);
+
+    Orderbook primary{false};
+    primary.replicateTo(sharedMemoryName());
+    EXPECT_THROW(MarketDataReader{sharedMemoryName()}, std::runtime_error);
+
+    const auto segment = MarketDataSegment::create(sharedMemoryName() + "_quotes", 1);
+    EXPECT_THROW(primary.publishMarketData(segment, 1), std::out_of_range);
+    EXPECT_THROW((void) MarketDataReader{segment.name()}.sequence(1), std::out_of_range);
+}
+
+TEST(MarketData, ConcurrentReadsAreNeverTorn) {
+    const auto segment = MarketDataSegment::create(sharedMemoryName(), 1);
+    QuoteSlot &slot = segment.slot(0);
+    constexpr std::uint32_t Writes = 200'000;
+
+    std::thread writer{[&slot] {
+        Quote quote{};
+        for (std::uint32_t k = 1; k <= Writes; ++k) {
+            quote.publishedNs = k;
+            quote.bidLevels = quote.askLevels = k % Quote::Depth;
+            for (std::size_t i = 0; i < Quote::Depth; ++i) {
+                quote.bids[i] = {static_cast<Price>(k), k, k};
+                quote.asks[i] = {static_cast<Price>(k), k, k};
+            }
+            slot.store(quote);
+        }
+    }};
+
+    std::uint64_t torn = 0;
+    Quote quote{};
+    while (slot.load(quote) < Writes) {
+        const std::uint64_t k = quote.publishedNs;
+        torn += quote.bidLevels != k % Quote::Depth || quote.askLevels != quote.bidLevels;
+        for (std::size_t i = 0; i < Quote::Depth; ++i) {
+            torn += quote.bids[i].quantity != k || quote.asks[i].price != static_cast<Price>(k);
+        }
+        std::this_thread::yield();
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+}
@@ -0,0 +1,82 @@
+#include "TestHelpers.h"
+
+namespace {
+    void restLadder(Orderbook &ob, OrderFactory &f) {
+        for (Price price = 90; price <= 99; ++price) {
+            ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, price, 1));
+            ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, price, 2));
+        }
+        for (Price price = 101; price <= 110; ++price) {
+            ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, price, 3));
+        }
+    }
+}
+
+TEST(MassCancel, CancelSide_LeavesOtherSideAlone) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restLadder(ob, f);
+
+    EXPECT_EQ(20, ob.cancelSide(Side::Buy));
+    EXPECT_EQ(10, ob.size());
+    EXPECT_TRUE(ob.getOrderInfos().getBids().empty());
+    EXPECT_EQ(10, ob.getOrderInfos().getAsks().size());
+    EXPECT_EQ(101.0, ob.getMidPrice());
+
+    EXPECT_EQ(0, ob.cancelSide(Side::Buy));
+
+    // Cancelled ids are gone and their prices are usable again.
+    ob.cancelOrder(0);
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 4));
+    EXPECT_EQ(11, ob.size());
+    EXPECT_EQ(100.0, ob.getMidPrice());
+}
+
+TEST(MassCancel, CancelPriceRange_IsInclusiveAndFixesBestAndWorst) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restLadder(ob, f);
+
+    // Clears the best five bid levels.
+    EXPECT_EQ(10, ob.cancelPriceRange(Side::Buy, 95, 1'000));
+    auto bids = ob.getOrderInfos().getBids();
+    ASSERT_EQ(5, bids.size());
+    EXPECT_EQ(94, bids.front().price);
+    EXPECT_EQ(90, bids.back().price);
+
+    // Clears the worst asks; a market buy must now stop at 105.
+    EXPECT_EQ(5, ob.cancelPriceRange(Side::Sell, 106, 110));
+    ob.addOrder(f.make(1'000, Side::Buy, 100));
+    EXPECT_EQ(5, ob.getTrades().size());
+    EXPECT_TRUE(ob.getOrderInfos().getAsks().empty());
+
+    // Ranges that miss the book are no-ops.
+    EXPECT_EQ(0, ob.cancelPriceRange(Side::Buy, 200, 300));
+    EXPECT_EQ(0, ob.cancelPriceRange(Side::Buy, 93, 92));
+    EXPECT_EQ(10, ob.size());
+}
+
+TEST(MassCancel, PublishesReportsAndLevelUpdates) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restLadder(ob, f);
+    auto &executions = ob.subscribeExecutions();
+    auto &l2 = ob.subscribeL2();
+    l2.poll([](const LevelUpdate &) {
+    });
+
+    ob.cancelPriceRange(Side::Buy, 98, 99);
+
+    std::vector<ExecutionReport> reports;
+    executions.poll([&](const ExecutionReport &r) { reports.push_back(r); });
+    ASSERT_EQ(4, reports.size());
+    for (const auto &r: reports) EXPECT_EQ(ExecutionReport::Type::Cancelled, r.type);
+
+    std::vector<LevelUpdate> updates;
+    l2.poll([&](const LevelUpdate &u) { updates.push_back(u); });
+    ASSERT_EQ(2, updates.size());
+    for (const auto &u: updates) {
+        EXPECT_EQ(0, u.count);
+        EXPECT_EQ(0, u.quantity);
+    }
+}
@@ -0,0 +1,144 @@
+#include "TestHelpers.h"
+
+TEST(OrderHandle, CancelByHandle) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto handle = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+    ASSERT_TRUE(handle.valid());
+
+    EXPECT_TRUE(ob.cancelOrder(handle));
+    EXPECT_EQ(1, ob.size());
+    EXPECT_EQ(5, ob.getOrderInfos().getBids()[0].quantity);
+
+    // Stale now, and the id is free again.
+    EXPECT_FALSE(ob.cancelOrder(handle));
+    EXPECT_TRUE(ob.addOrder(f.make(0, OrderType::GoodTillCancel, Side::Buy, 99, 1)).valid());
+}
+
+TEST(OrderHandle, StaleAfterSlotReuse) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto first = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 105, 10));
+    ob.cancelOrder(OrderId{0});
+
+    // The freed slot is handed to the next order; the old handle must not reach it.
+    const auto second = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 106, 10));
+    ASSERT_EQ(first.slot, second.slot);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(ob.cancelOrder(first));
+    EXPECT_FALSE(ob.modifyOrder(first, 107, 1).valid());
+    EXPECT_EQ(1, ob.size());
+    EXPECT_EQ(106, ob.getOrderInfos().getAsks()[0].price);
+}
+
+TEST(OrderHandle, NoHandleForOrdersThatDoNotRest) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto resting = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 10));
+    EXPECT_FALSE(ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 4)).valid());
+    EXPECT_FALSE(ob.addOrder(f.make(OrderType::FillAndKill, Side::Buy, 90, 4)).valid());
+    EXPECT_FALSE(ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 0)).valid());
+
+    // The partial fill above kept the resting order's handle live; filling the rest makes it stale.
+    const auto moved = ob.modifyOrder(resting, 101, 6);
+    ASSERT_TRUE(moved.valid());
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 6));
+    EXPECT_FALSE(ob.cancelOrder(moved));
+    EXPECT_EQ(0, ob.size());
+}
+
+TEST(OrderHandle, ModifyKeepsIdAndReturnsNewHandle) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto handle = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    const auto moved = ob.modifyOrder(handle, 98, 7);
+    ASSERT_TRUE(moved.valid());
+    EXPECT_FALSE(ob.cancelOrder(handle));
+
+    EXPECT_EQ(98, ob.getOrderInfos().getBids()[0].price);
+    EXPECT_EQ(7, ob.getOrderInfos().getBids()[0].quantity);
+
+    // The id-based API still sees the order, and cancelling by id makes the handle stale.
+    ob.cancelOrder(OrderId{0});
+    EXPECT_EQ(0, ob.size());
+    EXPECT_FALSE(ob.cancelOrder(moved));
+}
+
+TEST(OrderHandle, ModifyThatCrossesFills) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 5));
+    const auto bid = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 5));
+
+    EXPECT_FALSE(ob.modifyOrder(bid, 101, 5).valid());
+    EXPECT_EQ(1, ob.getTrades().size());
+    EXPECT_EQ(0, ob.size());
+}
+
+TEST(OrderHandle, StaleAfterReset) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto before = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ob.reset();
+    const auto after = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    ASSERT_EQ(before.slot, after.slot);
+    EXPECT_FALSE(ob.cancelOrder(before));
+    EXPECT_TRUE(ob.cancelOrder(after));
+}
+
+TEST(OrderHandle, IdApiAfterHandleCancels) {
+    OrderFactory f;
+    Orderbook ob{false};
+    std::vector<OrderHandle> handles;
+    for (int i = 0; i < 5'000; ++i) {
+        handles.push_back(ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100 + i % 50, 1)));
+    }
+
+    // Enough to trigger the sweep of stale id entries at least once.
+    for (int i = 0; i < 4'000; ++i) EXPECT_TRUE(ob.cancelOrder(handles[i]));
+    EXPECT_EQ(1'000, ob.size());
+
+    // Ids cancelled by handle are unknown to the id API and can be reused.
+    ob.cancelOrder(OrderId{1});
+    ob.modifyOrder({2, Side::Buy, 90, 1});
+    EXPECT_EQ(1'000, ob.size());
+    EXPECT_TRUE(ob.addOrder(f.make(3, OrderType::GoodTillCancel, Side::Buy, 90, 1)).valid());
+    EXPECT_EQ(1'001, ob.size());
+
+    // Ids still resting work by id as before.
+    ob.cancelOrder(OrderId{4'999});
+    ob.modifyOrder({4'998, Side::Buy, 91, 1});
+    EXPECT_EQ(1'000, ob.size());
+    EXPECT_FALSE(ob.cancelOrder(handles[4'999]));
+    EXPECT_FALSE(ob.cancelOrder(handles[4'998]));
+}
+
+TEST(OrderHandle, ReduceKeepsQueuePriority) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto front = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+    const auto behind = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 10));
+
+    EXPECT_EQ(4, ob.reduceOrder(front, 6));
+    EXPECT_EQ(14, ob.getOrderInfos().getBids()[0].quantity);
+    EXPECT_EQ(2, ob.size());
+
+    // Still first in the queue, so it takes the whole sell.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 4));
+    EXPECT_FALSE(ob.cancelOrder(front));
+    EXPECT_EQ(10, ob.getOrderInfos().getBids()[0].quantity);
+    EXPECT_TRUE(ob.cancelOrder(behind));
+}
+
+TEST(OrderHandle, ReduceByTheRemainderCancels) {
+    OrderFactory f;
+    Orderbook ob{false};
+    const auto handle = ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 105, 10));
+
+    EXPECT_EQ(7, ob.reduceOrder(OrderId{0}, 3));
+    EXPECT_EQ(0, ob.reduceOrder(OrderId{0}, 50));
+    EXPECT_EQ(0, ob.size());
+    EXPECT_FALSE(ob.reduceOrder(OrderId{0}, 1));
+    EXPECT_FALSE(ob.reduceOrder(handle, 1));
+}
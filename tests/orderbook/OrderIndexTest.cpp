@@ -0,0 +1,89 @@
+#include "orderbook/OrderIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+template<class Index>
+class OrderIndexTest : public testing::Test {
+protected:
+    Index index;
+};
+
+using OrderIndexPolicies = testing::Types<HashOrderIndex, DirectOrderIndex>;
+TYPED_TEST_SUITE(OrderIndexTest, OrderIndexPolicies);
+
+TYPED_TEST(OrderIndexTest, InsertFindExtract) {
+    auto &index = this->index;
+    index.insert(100, {7, 1});
+    index.insert(101, {8, 0});
+
+    EXPECT_EQ((OrderHandle{7, 1}), index.find(100));
+    EXPECT_TRUE(index.contains(101));
+    EXPECT_FALSE(index.contains(102));
+    EXPECT_FALSE(index.find(99).valid());
+    EXPECT_EQ(2u, index.size());
+
+    EXPECT_EQ((OrderHandle{7, 1}), index.extract(100));
+    EXPECT_FALSE(index.extract(100).valid());
+    EXPECT_EQ(1u, index.size());
+
+    index.clear();
+    EXPECT_EQ(0u, index.size());
+    EXPECT_FALSE(index.contains(101));
+}
+
+// Dense ids, ids below the first one, a far-away id and the whole range cancelled out of order,
+// checked against a std::map after every step.
+TYPED_TEST(OrderIndexTest, AgreesWithMapOnMixedIds) {
+    auto &index = this->index;
+    std::map<OrderId, OrderHandle> expected;
+    const auto insert = [&](OrderId id) {
+        const OrderHandle handle{static_cast<OrderSlot>(id % 1'000'003), static_cast<std::uint32_t>(id % 7)};
+        index.insert(id, handle);
+        expected.emplace(id, handle);
+    };
+
+    for (OrderId id = 5'000; id < 25'000; ++id) insert(id);
+    insert(10);
+    insert(OrderId{1} << 40);
+    for (OrderId id = 5'000; id < 25'000; id += 3) {
+        EXPECT_EQ(expected[id], index.extract(id));
+        expected.erase(id);
+    }
+    for (OrderId id = 25'000; id < 30'000; ++id) insert(id);
+
+    EXPECT_EQ(expected.size(), index.size());
+    std::size_t visited = 0;
+    index.forEach([&](OrderId id, OrderHandle handle) {
+        EXPECT_EQ(expected.at(id), handle);
+        ++visited;
+    });
+    EXPECT_EQ(expected.size(), visited);
+
+    for (const auto &[id, handle]: expected) EXPECT_EQ(handle, index.extract(id));
+    EXPECT_EQ(0u, index.size());
+}
+
+TEST(DirectOrderIndex, RecyclesDeadPages) {
+    DirectOrderIndex index;
+    constexpr OrderId perPage = DirectOrderIndex::PageSize;
+
+    // A sliding window of live ids: ids die in order, a few pages behind the newest.
+    for (OrderId id = 0; id < 64 * perPage; ++id) {
+        index.insert(id, {static_cast<OrderSlot>(id), 0});
+        if (id >= 2 * perPage) {
+            EXPECT_EQ(id - 2 * perPage, index.extract(id - 2 * perPage).slot);
+        }
+    }
+
+    EXPECT_LE(index.livePages(), 3u);
+    EXPECT_LE(index.livePages() + index.freePages(), 4u);
+    EXPECT_EQ(static_cast<OrderSlot>(64 * perPage - 1), index.find(64 * perPage - 1).slot);
+    EXPECT_FALSE(index.find(0).valid());
+
+    // Ids below the advanced base still work, through the overflow map.
+    index.insert(3, {3, 0});
+    EXPECT_EQ(3u, index.find(3).slot);
+    EXPECT_EQ(3u, index.extract(3).slot);
+}
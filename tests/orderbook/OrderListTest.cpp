@@ -0,0 +1,27 @@
+#include "TestHelpers.h"
+
+TEST(OrderList, KeepsFifoOrderAcrossEraseAndReuse) {
+    OrderFactory f;
+    OrderPool pool;
+    Orders orders{pool};
+
+    const OrderSlot first = orders.push_back(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 1));
+    const OrderSlot middle = orders.push_back(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 2));
+    orders.push_back(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 3));
+
+    orders.erase(middle);
+    const OrderSlot reused = orders.push_back(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 4));
+    EXPECT_EQ(middle, reused);
+
+    std::vector<OrderId> ids;
+    for (const auto &order: orders) ids.push_back(order.getId());
+    EXPECT_EQ((std::vector<OrderId>{0, 2, 3}), ids);
+
+    orders.pop_front();
+    EXPECT_EQ(2, orders.front().getId());
+    EXPECT_NE(first, orders.frontSlot());
+
+    orders.pop_front();
+    orders.pop_front();
+    EXPECT_TRUE(orders.empty());
+}
@@ -0,0 +1,56 @@
+#include "TestHelpers.h"
+
+TEST(OwnerCancel, CancelsOnlyThatOwnersRestingOrders) {
+    Orderbook ob{false};
+    ob.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 5, 7});
+    ob.addOrder({2, OrderType::GoodTillCancel, Side::Buy, 100, 5, 8});
+    ob.addOrder({3, OrderType::GoodTillCancel, Side::Sell, 110, 5, 7});
+    ob.addOrder({4, OrderType::GoodTillCancel, Side::Buy, 99, 5, 7});
+    ob.addOrder({5, OrderType::GoodTillCancel, Side::Sell, 111, 5});
+    EXPECT_EQ(3, ob.ownerOrderCount(7));
+
+    EXPECT_EQ(3, ob.cancelAllForOwner(7));
+    EXPECT_EQ(0, ob.ownerOrderCount(7));
+    EXPECT_EQ(2, ob.size());
+
+    const auto infos = ob.getOrderInfos();
+    ASSERT_EQ(1, infos.getBids().size());
+    EXPECT_EQ(100, infos.getBids()[0].price);
+    EXPECT_EQ(5, infos.getBids()[0].quantity);
+    ASSERT_EQ(1, infos.getAsks().size());
+    EXPECT_EQ(111, infos.getAsks()[0].price);
+
+    EXPECT_EQ(0, ob.cancelAllForOwner(7));
+    EXPECT_EQ(0, ob.cancelAllForOwner(999));
+}
+
+TEST(OwnerCancel, FilledAndCancelledOrdersLeaveTheOwnerList) {
+    Orderbook ob{false};
+    ob.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 100, 5, 3});
+    ob.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 101, 5, 3});
+    ob.addOrder({3, OrderType::GoodTillCancel, Side::Sell, 102, 5, 3});
+    ob.addOrder({4, OrderType::GoodTillCancel, Side::Buy, 100, 5, 4});
+    ob.cancelOrder(2);
+    EXPECT_EQ(1, ob.ownerOrderCount(3));
+    EXPECT_EQ(0, ob.ownerOrderCount(4));
+
+    // A partial fill keeps the order listed.
+    ob.addOrder({5, OrderType::GoodTillCancel, Side::Buy, 102, 2});
+    EXPECT_EQ(1, ob.ownerOrderCount(3));
+
+    EXPECT_EQ(1, ob.cancelAllForOwner(3));
+    EXPECT_EQ(0, ob.size());
+}
+
+TEST(OwnerCancel, ModifyKeepsOwnerAndMassCancelUnlinks) {
+    Orderbook ob{false};
+    ob.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 5, 9});
+    ob.addOrder({2, OrderType::GoodTillCancel, Side::Buy, 90, 5, 9});
+    ob.modifyOrder({1, Side::Buy, 95, 3});
+    EXPECT_EQ(2, ob.ownerOrderCount(9));
+
+    EXPECT_EQ(1, ob.cancelPriceRange(Side::Buy, 91, 100));
+    EXPECT_EQ(1, ob.ownerOrderCount(9));
+    EXPECT_EQ(1, ob.cancelAllForOwner(9));
+    EXPECT_EQ(0, ob.size());
+}
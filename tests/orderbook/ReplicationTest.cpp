@@ -0,0 +1,99 @@
+#include "TestHelpers.h"
+#include "orderbook/StandbyReplica.h"
+
+#include <system_error>
+
+TEST(Replication, StandbyTracksPrimaryInLockstep) {
+    Orderbook primary{false};
+    primary.replicateTo(sharedMemoryName());
+    StandbyReplica standby{sharedMemoryName()};
+
+    RandomFlow flow{3};
+    for (int round = 0; round < 20; ++round) {
+        flow.run(primary, 200);
+        standby.poll();
+        ASSERT_EQ(primary.bookHash(), standby.book().bookHash()) << "round " << round;
+    }
+    EXPECT_EQ(primary.size(), standby.book().size());
+    EXPECT_EQ(primary.stopCount(), standby.book().stopCount());
+    EXPECT_EQ(primary.getLastTradePrice(), standby.book().getLastTradePrice());
+    EXPECT_EQ(primary.getTrades(), standby.book().getTrades());
+
+    primary.reset();
+    standby.poll();
+    EXPECT_EQ(0, standby.book().size());
+}
+
+TEST(Replication, LagInEventsAndNanoseconds) {
+    Orderbook primary{false};
+    ReplicationPublisher &publisher = primary.replicateTo(sharedMemoryName());
+    StandbyReplica standby{sharedMemoryName()};
+
+    for (OrderId id = 0; id < 10; ++id) primary.addOrder({id, OrderType::GoodTillCancel, Side::Buy, 100, 1});
+    const ReplicationLag behind = standby.lag();
+    EXPECT_EQ(10, behind.events);
+    EXPECT_GT(behind.nanoseconds, 0);
+    EXPECT_EQ(10, publisher.lag().events);
+
+    EXPECT_EQ(10, standby.poll());
+    EXPECT_EQ(0, standby.lag().events);
+    EXPECT_EQ(0, standby.lag().nanoseconds);
+    EXPECT_EQ(0, publisher.lag().events);
+    EXPECT_EQ(10, standby.applyLatency().count());
+}
+
+TEST(Replication, PromoteAfterPrimaryGoesAway) {
+    std::uint64_t primaryHash;
+    std::optional<StandbyReplica> standby;
+    {
+        Orderbook primary{false};
+        primary.replicateTo(sharedMemoryName());
+        standby.emplace(sharedMemoryName());
+        primary.addOrder({1, OrderType::GoodTillCancel, Side::Sell, 101, 10});
+        primary.addOrder({2, OrderType::GoodTillCancel, Side::Buy, 99, 10});
+        primary.addOrder({3, OrderType::GoodTillCancel, Side::Buy, 101, 4});
+        primaryHash = primary.bookHash();
+    }
+    EXPECT_TRUE(standby->primaryClosed());
+
+    // The ring outlives the primary's unlink while mapped, so the tail is still applied.
+    Orderbook &book = standby->promote();
+    EXPECT_EQ(primaryHash, book.bookHash());
+    EXPECT_EQ(2, book.size());
+    book.addOrder({4, OrderType::GoodTillCancel, Side::Buy, 101, 6});
+    EXPECT_EQ(1, book.size());
+    EXPECT_EQ(0, standby->poll());
+}
+
+TEST(Replication, OverrunStopsReplication) {
+    Orderbook primary{false};
+    ReplicationPublisher &publisher = primary.replicateTo(sharedMemoryName(), 16);
+    StandbyReplica standby{sharedMemoryName()};
+
+    for (OrderId id = 0; id < 20; ++id) primary.addOrder({id, OrderType::GoodTillCancel, Side::Buy, 100, 1});
+    EXPECT_TRUE(publisher.overrun());
+    EXPECT_EQ(16, publisher.published());
+    EXPECT_TRUE(standby.overrun());
+    EXPECT_THROW(standby.promote(), std::runtime_error);
+}
+
+TEST(Replication, StartsOnlyFromAnEmptyBook) {
+    Orderbook primary{false};
+    primary.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 1});
+    EXPECT_THROW(primary.replicateTo(sharedMemoryName()), std::logic_error);
+    EXPECT_THROW(StandbyReplica{sharedMemoryName()}, std::system_error);
+
+    // Emptied by trading: the last trade price would fire stops on the primary but not the standby.
+    Orderbook traded{false};
+    traded.addOrder({1, OrderType::GoodTillCancel, Side::Buy, 100, 1});
+    traded.addOrder({2, OrderType::GoodTillCancel, Side::Sell, 100, 1});
+    ASSERT_EQ(0, traded.size());
+    EXPECT_THROW(traded.replicateTo(sharedMemoryName()), std::logic_error);
+    traded.reset();
+    EXPECT_NO_THROW(traded.replicateTo(sharedMemoryName()));
+
+    // Empty but in an auction: crossing adds would rest on the primary and match on the standby.
+    Orderbook auction{false};
+    auction.openAuction();
+    EXPECT_THROW(auction.replicateTo(sharedMemoryName()), std::logic_error);
+}
@@ -0,0 +1,78 @@
+#include "TestHelpers.h"
+#include "orderbook/BookPool.h"
+
+TEST(Reset, EmptiesBookAndAllowsReuse) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 10, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 59'000, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 59'500, 3));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 59'000, 2));
+    ASSERT_FALSE(ob.getTrades().empty());
+
+    ob.reset();
+
+    EXPECT_EQ(0, ob.size());
+    EXPECT_TRUE(ob.getTrades().empty());
+    EXPECT_FALSE(ob.getMidPrice().has_value());
+    EXPECT_TRUE(ob.getOrderInfos().getBids().empty());
+    EXPECT_TRUE(ob.getOrderInfos().getAsks().empty());
+
+    // Ids and prices from before the reset are free again.
+    OrderFactory g;
+    ob.addOrder(g.make(OrderType::GoodTillCancel, Side::Sell, 200, 4));
+    ob.addOrder(g.make(OrderType::GoodTillCancel, Side::Buy, 100, 4));
+    ob.addOrder(g.make(OrderType::GoodTillCancel, Side::Buy, 10, 1));
+    EXPECT_EQ(3, ob.size());
+    EXPECT_EQ(150.0, ob.getMidPrice());
+
+    const auto infos = ob.getOrderInfos();
+    ASSERT_EQ(2, infos.getBids().size());
+    EXPECT_EQ(100, infos.getBids()[0].price);
+    EXPECT_EQ(4, infos.getBids()[0].quantity);
+    EXPECT_EQ(1, infos.getBids()[1].quantity);
+
+    ob.addOrder(g.make(OrderType::GoodTillCancel, Side::Sell, 10, 5));
+    EXPECT_EQ(1, ob.size());
+    EXPECT_EQ(2, ob.getTrades().size());
+}
+
+TEST(Reset, DropsSubscriptions) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.subscribeL2();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+
+    ob.reset();
+
+    // A fresh subscription publishes the (empty) current depth and starts at sequence 1.
+    auto &feed = ob.subscribeL2();
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 2));
+    LevelUpdate update{};
+    ASSERT_TRUE(feed.tryPop(update));
+    EXPECT_EQ(1, update.sequence);
+    EXPECT_EQ(2, update.quantity);
+    EXPECT_FALSE(feed.tryPop(update));
+}
+
+TEST(BookPool, ReleasedBookIsReusedEmpty) {
+    OrderFactory f;
+    BookPool pool{{}, 1};
+    EXPECT_EQ(1, pool.idle());
+
+    const Orderbook *first;
+    {
+        auto book = pool.acquire();
+        first = book.get();
+        EXPECT_EQ(0, pool.idle());
+        book->addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+    }
+    EXPECT_EQ(1, pool.idle());
+
+    auto book = pool.acquire();
+    EXPECT_EQ(first, book.get());
+    EXPECT_EQ(0, book->size());
+
+    auto extra = pool.acquire();
+    EXPECT_NE(book.get(), extra.get());
+}
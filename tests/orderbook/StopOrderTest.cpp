@@ -0,0 +1,129 @@
+#include "TestHelpers.h"
+
+TEST(StopOrder, BuyStopFiresWhenLastTradeReachesStopPrice) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 5));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 105, 5));
+    ob.addStopOrder(f.make(10, Side::Buy, 3), 101);
+    EXPECT_EQ(1, ob.stopCount());
+
+    // Trades at 100: below the stop.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 5));
+    EXPECT_EQ(1, ob.stopCount());
+    EXPECT_EQ(100, ob.getLastTradePrice());
+
+    // Trades at 105: the stop becomes a market buy and lifts the rest of the 105 offer.
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 105, 1));
+    EXPECT_EQ(0, ob.stopCount());
+    ASSERT_EQ(3, ob.getTrades().size());
+    EXPECT_EQ(10, ob.getTrades().back().getBidId());
+    EXPECT_EQ(1, ob.size());
+}
+
+TEST(StopOrder, SellStopLimitRestsAfterFiring) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 2));
+    ob.addStopOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 98, 4), 100);
+
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 2));
+    EXPECT_EQ(0, ob.stopCount());
+
+    const auto infos = ob.getOrderInfos();
+    EXPECT_TRUE(infos.getBids().empty());
+    ASSERT_EQ(1, infos.getAsks().size());
+    EXPECT_EQ(98, infos.getAsks()[0].price);
+    EXPECT_EQ(4, infos.getAsks()[0].quantity);
+}
+
+TEST(StopOrder, TriggersCascadeWithinOneCall) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 1));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 95, 1));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 90, 1));
+    ob.addStopOrder(f.make(20, Side::Sell, 1), 100); // fires at 100, trades at 95
+    ob.addStopOrder(f.make(21, Side::Sell, 1), 96); // fires at 95, trades at 90
+    ob.addStopOrder(f.make(22, Side::Sell, 1), 80); // never reached
+
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 1));
+
+    EXPECT_EQ(3, ob.getTrades().size());
+    EXPECT_EQ(90, ob.getLastTradePrice());
+    EXPECT_EQ(1, ob.stopCount());
+    EXPECT_EQ(0, ob.size());
+}
+
+TEST(StopOrder, AlreadyCrossedStopFiresOnArrival) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 100, 1));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 100, 1));
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 1));
+
+    ob.addStopOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 101, 1), 99);
+    EXPECT_EQ(0, ob.stopCount());
+    EXPECT_EQ(2, ob.getTrades().size());
+}
+
+TEST(StopOrder, CancelRejectAndReports) {
+    OrderFactory f;
+    Orderbook ob{false};
+    auto &executions = ob.subscribeExecutions();
+
+    ob.addStopOrder(f.make(1, OrderType::GoodTillCancel, Side::Buy, 110, 1), 105);
+    ob.addStopOrder(f.make(1, OrderType::GoodTillCancel, Side::Buy, 110, 1), 106);
+    ob.addOrder(f.make(1, OrderType::GoodTillCancel, Side::Buy, 90, 1));
+    ob.addStopOrder(f.make(2, Side::Sell, 1), -5);
+    EXPECT_EQ(1, ob.stopCount());
+
+    ob.cancelOrder(1);
+    EXPECT_EQ(0, ob.stopCount());
+
+    using enum ExecutionReport::Type;
+    std::vector<ExecutionReport::Type> types;
+    executions.poll([&](const ExecutionReport &r) { types.push_back(r.type); });
+    EXPECT_EQ((std::vector{Accepted, Rejected, Rejected, Rejected, Cancelled}), types);
+}
+
+TEST(StopOrder, OwnerCancelTakesParkedStopsButNotFiredOnes) {
+    Orderbook ob{false};
+    ob.addStopOrder({1, OrderType::GoodTillCancel, Side::Buy, 110, 1, 7}, 105);
+    ob.addStopOrder({2, OrderType::GoodTillCancel, Side::Sell, 90, 1, 7}, 95);
+    ob.addStopOrder({3, OrderType::GoodTillCancel, Side::Sell, 90, 1, 8}, 96);
+
+    // Fires order 1, which rests at 110 as an ordinary order of owner 7.
+    ob.addOrder({4, OrderType::GoodTillCancel, Side::Sell, 105, 1});
+    ob.addOrder({5, OrderType::GoodTillCancel, Side::Buy, 105, 1});
+    ASSERT_EQ(2, ob.stopCount());
+    ASSERT_EQ(1, ob.ownerOrderCount(7));
+
+    EXPECT_EQ(2, ob.cancelAllForOwner(7));
+    EXPECT_EQ(1, ob.stopCount());
+    EXPECT_EQ(0, ob.size());
+    EXPECT_EQ(0, ob.cancelAllForOwner(7));
+    EXPECT_EQ(1, ob.cancelAllForOwner(8));
+    EXPECT_EQ(0, ob.stopCount());
+}
+
+TEST(StopOrder, ParkedGoodForDayStopsExpireAtTheClose) {
+    Orderbook ob{false};
+    auto &executions = ob.subscribeExecutions();
+    ob.addStopOrder({1, OrderType::GoodForDay, Side::Buy, 110, 1}, 105);
+    ob.addStopOrder({2, OrderType::GoodTillCancel, Side::Buy, 110, 1}, 105);
+
+    PruneTestHelper::pruneStaleGoodForNow(ob);
+    EXPECT_EQ(1, ob.stopCount());
+
+    std::vector<std::pair<OrderId, ExecutionReport::Type> > reports;
+    executions.poll([&](const ExecutionReport &r) { reports.emplace_back(r.orderId, r.type); });
+    ASSERT_EQ(3, reports.size());
+    EXPECT_EQ(std::pair(OrderId{1}, ExecutionReport::Type::Expired), reports.back());
+
+    // The next day's trade at 105 fires only the GTC stop, which rests as a bid at 110.
+    ob.addOrder({3, OrderType::GoodTillCancel, Side::Sell, 105, 1});
+    ob.addOrder({4, OrderType::GoodTillCancel, Side::Buy, 105, 1});
+    EXPECT_EQ(0, ob.stopCount());
+    EXPECT_EQ(1, ob.size());
+}
@@ -0,0 +1,101 @@
+#include "TestHelpers.h"
+
+namespace {
+    // Asks: 10 @ 101, 20 @ 103, 5 @ 104. Bids: 4 @ 99, 6 @ 97.
+    void restBook(Orderbook &ob, OrderFactory &f) {
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 101, 10));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 103, 15));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 103, 5));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Sell, 104, 5));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 4));
+        ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 97, 6));
+    }
+}
+
+TEST(SweepEstimate, BuyWalksAsksFromBest) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restBook(ob, f);
+
+    const auto estimate = ob.estimateSweep(Side::Buy, 25);
+    EXPECT_TRUE(estimate.complete());
+    EXPECT_EQ(25, estimate.filled);
+    EXPECT_EQ(10 * 101 + 15 * 103, estimate.notional);
+    EXPECT_EQ(103, estimate.worstPrice);
+    EXPECT_EQ(2, estimate.levels);
+    EXPECT_DOUBLE_EQ((10.0 * 101 + 15.0 * 103) / 25, *estimate.vwap());
+
+    // Nothing is executed.
+    EXPECT_EQ(6, ob.size());
+    EXPECT_TRUE(ob.getTrades().empty());
+}
+
+TEST(SweepEstimate, SellWalksBidsAndReportsShortfall) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restBook(ob, f);
+
+    const auto estimate = ob.estimateSweep(Side::Sell, 50);
+    EXPECT_FALSE(estimate.complete());
+    EXPECT_EQ(10, estimate.filled);
+    EXPECT_EQ(4 * 99 + 6 * 97, estimate.notional);
+    EXPECT_EQ(97, estimate.worstPrice);
+    EXPECT_EQ(2, estimate.levels);
+}
+
+TEST(SweepEstimate, EmptySideAndZeroSize) {
+    OrderFactory f;
+    Orderbook ob{false};
+    ob.addOrder(f.make(OrderType::GoodTillCancel, Side::Buy, 99, 4));
+
+    const auto noAsks = ob.estimateSweep(Side::Buy, 5);
+    EXPECT_EQ(0, noAsks.filled);
+    EXPECT_FALSE(noAsks.worstPrice.has_value());
+    EXPECT_FALSE(noAsks.vwap().has_value());
+
+    const auto zero = ob.estimateSweep(Side::Sell, 0);
+    EXPECT_TRUE(zero.complete());
+    EXPECT_EQ(0, zero.levels);
+}
+
+TEST(SweepEstimate, BatchMatchesSingleQueries) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restBook(ob, f);
+
+    const std::vector<Quantity> sizes{0, 1, 10, 11, 30, 35, 36, 1'000};
+    std::vector<SweepEstimate> batch(sizes.size());
+    ob.estimateSweeps(Side::Buy, sizes, batch);
+
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        const auto single = ob.estimateSweep(Side::Buy, sizes[i]);
+        EXPECT_EQ(single.requested, batch[i].requested) << sizes[i];
+        EXPECT_EQ(single.filled, batch[i].filled) << sizes[i];
+        EXPECT_EQ(single.notional, batch[i].notional) << sizes[i];
+        EXPECT_EQ(single.worstPrice, batch[i].worstPrice) << sizes[i];
+        EXPECT_EQ(single.levels, batch[i].levels) << sizes[i];
+    }
+    EXPECT_EQ(104, batch[5].worstPrice);
+    EXPECT_EQ(3, batch[5].levels);
+    EXPECT_FALSE(batch[6].complete());
+}
+
+TEST(SweepEstimate, BatchRejectsUnsortedSizes) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restBook(ob, f);
+
+    const std::vector<Quantity> sizes{10, 1};
+    std::vector<SweepEstimate> batch(sizes.size());
+    EXPECT_THROW(ob.estimateSweeps(Side::Buy, sizes, batch), std::invalid_argument);
+}
+
+TEST(SweepEstimate, BatchRejectsShortOutput) {
+    OrderFactory f;
+    Orderbook ob{false};
+    restBook(ob, f);
+
+    const std::vector<Quantity> sizes{1, 10, 30};
+    std::vector<SweepEstimate> batch(sizes.size() - 1);
+    EXPECT_THROW(ob.estimateSweeps(Side::Buy, sizes, batch), std::invalid_argument);
+}
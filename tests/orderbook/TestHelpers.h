@@ -6,7 +6,11 @@
 #define ORDERBOOK_TESTHELPERS_H
 
 #include "orderbook/Orderbook.h"
+#include "orderbook/L2BookBuilder.h"
+#include "shared/Philox.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
 
 struct OrderFactory {
     OrderId id = 0;
@@ -31,6 +35,85 @@ inline bool hasTradeLike(const Trades &trades, const Trade &trade) {
                                });
 }
 
+// A shared memory object name unique to the running test, suite included.
+inline std::string sharedMemoryName() {
+    const auto *test = ::testing::UnitTest::GetInstance()->current_test_info();
+    return std::string{"/orderbook_test_"} + test->test_suite_name() + "_" + test->name();
+}
+
+// Checks that an L2 consumer's rebuilt depth matches the book level for level.
+inline void expectSameDepth(const L2BookBuilder &builder, const Orderbook &ob) {
+    const auto infos = ob.getOrderInfos();
+    const auto bids = builder.getBids();
+    const auto asks = builder.getAsks();
+    ASSERT_EQ(infos.getBids().size(), bids.size());
+    ASSERT_EQ(infos.getAsks().size(), asks.size());
+    for (std::size_t i = 0; i < bids.size(); ++i) {
+        EXPECT_EQ(infos.getBids()[i].price, bids[i].price);
+        EXPECT_EQ(infos.getBids()[i].quantity, bids[i].quantity);
+    }
+    for (std::size_t i = 0; i < asks.size(); ++i) {
+        EXPECT_EQ(infos.getAsks()[i].price, asks[i].price);
+        EXPECT_EQ(infos.getAsks()[i].quantity, asks[i].quantity);
+    }
+}
+
+// A seeded random flow over every input the book takes: adds of each type, stops, cancels,
+// modifies and reductions by id and by handle, mass and owner cancels, and a call auction every
+// 500 steps.
+// Prices stay within 95..105 so most orders meet.
+struct RandomFlow {
+    PhiloxStream rng;
+    OrderId nextId{0};
+    std::vector<OrderHandle> handles;
+    int steps{0};
+
+    explicit RandomFlow(std::uint64_t seed) : rng{seed, 0, 0} {
+    }
+
+    void run(Orderbook &ob, int count) {
+        for (int i = 0; i < count; ++i) step(ob);
+    }
+
+    void step(Orderbook &ob) {
+        const int step = steps++;
+        const auto side = rng.below(2) == 0 ? Side::Buy : Side::Sell;
+        const auto price = static_cast<Price>(95 + rng.below(11));
+        const auto quantity = 1 + rng.below(20);
+        const auto owner = static_cast<OwnerId>(rng.below(4));
+        switch (rng.below(15)) {
+            case 0: ob.cancelOrder(static_cast<OrderId>(rng.below(nextId + 1)));
+                break;
+            case 1: if (!handles.empty()) ob.cancelOrder(handles[rng.below(handles.size())]);
+                break;
+            case 2: ob.modifyOrder({static_cast<OrderId>(rng.below(nextId + 1)), side, price, quantity});
+                break;
+            case 3: if (!handles.empty()) ob.modifyOrder(handles[rng.below(handles.size())], price, quantity);
+                break;
+            case 4: ob.addOrder({nextId++, side, quantity});
+                break;
+            case 5: ob.addStopOrder({nextId++, OrderType::GoodTillCancel, side, price, quantity}, price);
+                break;
+            case 6: if (step % 40 == 0) ob.cancelPriceRange(side, price - 1, price + 1);
+                else if (step % 40 == 1) ob.cancelAllForOwner(owner);
+                break;
+            case 7: ob.addOrder({nextId++, OrderType::FillAndKill, side, price, quantity});
+                break;
+            case 8: ob.addOrder({nextId++, OrderType::FillOrKill, side, price, quantity});
+                break;
+            case 9: ob.reduceOrder(static_cast<OrderId>(rng.below(nextId + 1)), quantity);
+                break;
+            case 10: if (!handles.empty()) ob.reduceOrder(handles[rng.below(handles.size())], quantity);
+                break;
+            default: handles.push_back(ob.addOrder({
+                    nextId++, OrderType::GoodTillCancel, side, price, quantity, owner
+                }));
+        }
+        if (step % 500 == 250) ob.openAuction();
+        if (step % 500 == 300) ob.uncross();
+    }
+};
+
 class PruneTestHelper {
 public:
     static void pruneStaleGoodForNow(Orderbook &ob) {
@@ -0,0 +1,39 @@
+#include "synthetic_order_generator/CompactOrderEvent.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace {
+    template<class T>
+    std::string print(const T &e) {
+        std::ostringstream os;
+        os << e;
+        return os.str();
+    }
+}
+
+TEST(CompactOrderEvent, RoundTripsEveryEventKind) {
+    const std::vector<OrderEvent> events{
+        OrderEvent::New(Order{1, OrderType::FillOrKill, Side::Sell, 9975, 42}),
+        OrderEvent::New(Order{2, Side::Buy, 7}),
+        OrderEvent::Modify(OrderModify{3, Side::Buy, 9980, 11}),
+        OrderEvent::Cancel(4)
+    };
+
+    for (const auto &event: events) {
+        const auto compact = CompactOrderEvent::from(event);
+        EXPECT_EQ(event.event_, compact.event);
+        EXPECT_EQ(print(event), print(compact));
+        EXPECT_EQ(print(event), print(compact.toOrderEvent()));
+    }
+}
+
+TEST(CompactOrderEvent, ToOrderKeepsAllFields) {
+    const auto compact = CompactOrderEvent::New(Order{5, OrderType::GoodForDay, Side::Buy, 100, 3});
+    const Order order = compact.toOrder();
+
+    EXPECT_EQ(5, order.getId());
+    EXPECT_EQ(OrderType::GoodForDay, order.getType());
+    EXPECT_EQ(Side::Buy, order.getSide());
+    EXPECT_EQ(100, order.getPrice());
+    EXPECT_EQ(3, order.getRemainingQuantity());
+}
@@ -0,0 +1,95 @@
+#include "synthetic_order_generator/OrderGenerator.h"
+#include "synthetic_order_generator/OrderEventStream.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace {
+    std::string serialize(const std::vector<CompactOrderEvent> &events) {
+        std::ostringstream os;
+        for (const auto &e: events) os << e;
+        return os.str();
+    }
+
+    std::string generate(MarketState state, size_t ticks) {
+        OrderGenerator generator{state, ticks};
+        return serialize(generator.generate());
+    }
+}
+
+TEST(Philox, MatchesReferenceVectors) {
+    // Known-answer vectors from the Random123 distribution (kat_vectors, philox4x32_10).
+    EXPECT_EQ((Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}),
+              Philox4x32::generate({0, 0, 0, 0}, {0, 0}));
+    EXPECT_EQ((Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}),
+              Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}));
+}
+
+TEST(OrderGenerator, SameSeed_ProducesIdenticalFlow) {
+    MarketState state{};
+    state.seed = 7;
+
+    const auto first = generate(state, 5'000);
+    EXPECT_FALSE(first.empty());
+    EXPECT_EQ(first, generate(state, 5'000));
+}
+
+TEST(OrderGenerator, DifferentSeed_ProducesDifferentFlow) {
+    MarketState a{}, b{};
+    a.seed = 1;
+    b.seed = 2;
+
+    EXPECT_NE(generate(a, 1'000), generate(b, 1'000));
+}
+
+TEST(OrderGenerator, ThreadCount_DoesNotChangeFlow) {
+    MarketState serial{};
+    serial.seed = 1234;
+    MarketState parallel = serial;
+    parallel.threads = 4;
+
+    // Long enough to span several tick ranges per worker round.
+    constexpr size_t ticks = 100'000;
+    EXPECT_EQ(generate(serial, ticks), generate(parallel, ticks));
+}
+
+TEST(OrderEventStream, YieldsSameFlowAsGenerate) {
+    MarketState state{};
+    state.seed = 99;
+    constexpr size_t ticks = 40'000;
+
+    OrderGenerator generator{state, ticks};
+    OrderEventStream stream{generator};
+
+    std::vector<CompactOrderEvent> streamed;
+    for (const auto &e: stream) streamed.push_back(e);
+
+    EXPECT_EQ(generate(state, ticks), serialize(streamed));
+}
+
+TEST(OrderEventStream, UnboundedGenerator_CanBeAbandoned) {
+    MarketState state{};
+    OrderGenerator generator{state, OrderGenerator::Unbounded};
+
+    size_t seen = 0;
+    {
+        OrderEventStream stream{generator};
+        for (auto it = stream.begin(); it != stream.end() && seen < 500'000; ++it) ++seen;
+    }
+    EXPECT_EQ(500'000, seen);
+}
+
+TEST(OrderEventStream, UnboundedGenerator_RegistryTracksOnlyLiveOrders) {
+    MarketState state{};
+    OrderGenerator generator{state, OrderGenerator::Unbounded};
+
+    {
+        OrderEventStream stream{generator};
+        size_t seen = 0;
+        for (auto it = stream.begin(); it != stream.end() && seen < 1'000'000; ++it) ++seen;
+    }
+
+    // Cancels keep most issued ids dead; none of them may linger in the index.
+    const OrderRegistry &registry = generator.registry();
+    EXPECT_EQ(registry.size(), registry.indexedIds());
+    EXPECT_LT(registry.size() * 2, generator.issuedIds());
+}
@@ -0,0 +1,150 @@
+#include "synthetic_order_generator/ReplayEngine.h"
+#include "synthetic_order_generator/OrderExecutor.h"
+#include "synthetic_order_generator/OrderGenerator.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // A fresh directory of generated event files, removed again at the end of the test.
+    struct ReplayDirectory {
+        fs::path root = fs::temp_directory_path() /
+                        (std::string{"orderbook_replay_"} + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+
+        ReplayDirectory() {
+            fs::remove_all(root);
+            fs::create_directories(root);
+        }
+
+        ~ReplayDirectory() { fs::remove_all(root); }
+
+        std::string write(const std::string &name, std::uint64_t seed, size_t ticks) const {
+            MarketState state{};
+            state.seed = seed;
+            std::ofstream file{root / name};
+            for (const auto &e: OrderGenerator{state, ticks}.generate()) file << e;
+            return (root / name).string();
+        }
+    };
+
+    std::pair<std::size_t, std::size_t> serialReplay(const std::string &path) {
+        Orderbook book{false};
+        for (const auto &e: OrderExecutor::getOrdersFromCsv(path)) OrderExecutor::apply(book, e);
+        return {book.getTrades().size(), book.size()};
+    }
+}
+
+TEST(WorkStealingPool, RunsEveryTaskOnce) {
+    WorkStealingPool pool{4};
+    std::vector<std::atomic<int> > runs(1000);
+    pool.run(runs.size(), [&](std::size_t task, std::size_t worker) {
+        EXPECT_LT(worker, 4);
+        runs[task].fetch_add(1);
+    });
+    for (const auto &count: runs) EXPECT_EQ(1, count.load());
+}
+
+TEST(WorkStealingPool, IdleWorkersStealFromBusyOnes) {
+    WorkStealingPool pool{2};
+    // Worker 0 is dealt the even tasks and stalls on task 0 until worker 1 has run them all.
+    std::atomic<int> doneByOne{0};
+    std::atomic<bool> stolen{false};
+    pool.run(8, [&](std::size_t task, std::size_t worker) {
+        if (task == 0) {
+            while (doneByOne.load() < 7) std::this_thread::yield();
+            return;
+        }
+        if (worker == 1) {
+            doneByOne.fetch_add(1);
+            if (task % 2 == 0) stolen = true;
+        }
+    });
+    EXPECT_TRUE(stolen);
+}
+
+TEST(WorkStealingPool, RethrowsTaskFailure) {
+    WorkStealingPool pool{3};
+    EXPECT_THROW(pool.run(10, [](std::size_t task, std::size_t) {
+        if (task == 5) throw std::runtime_error("bad file");
+    }), std::runtime_error);
+}
+
+TEST(ReplayEngine, MatchesSerialReplayPerFile) {
+    const ReplayDirectory dir;
+    std::vector<std::string> files;
+    for (int i = 0; i < 6; ++i) files.push_back(dir.write("day" + std::to_string(i) + ".csv", 100 + i, 1'000 + 500 * i));
+
+    ReplayEngine engine{3};
+    const ReplayReport report = engine.run(dir.root.string());
+    ASSERT_EQ(files.size(), report.files.size());
+    EXPECT_EQ(3, report.workers);
+
+    std::size_t events = 0;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const FileReplay &file = report.files[i];
+        EXPECT_EQ(files[i], file.path);
+        EXPECT_EQ(OrderExecutor::getOrdersFromCsv(files[i]).size(), file.events);
+        const auto [trades, resting] = serialReplay(files[i]);
+        EXPECT_EQ(trades, file.trades);
+        EXPECT_EQ(resting, file.resting);
+        events += file.events;
+    }
+    EXPECT_EQ(events, report.events());
+    EXPECT_GT(report.eventsPerSecond(), 0);
+}
+
+TEST(ReplayEngine, ReadsManifest) {
+    const ReplayDirectory dir;
+    const std::string a = dir.write("a.csv", 1, 500);
+    dir.write("b.csv", 2, 500);
+    std::ofstream{dir.root / "manifest.txt"} << "# one file, twice\n\na.csv\n" << a << "\n";
+
+    const auto files = ReplayEngine::listFiles((dir.root / "manifest.txt").string());
+    ASSERT_EQ(2, files.size());
+    EXPECT_EQ(fs::path{a}, fs::path{files[0]});
+    EXPECT_EQ(a, files[1]);
+
+    ReplayEngine engine{2};
+    const ReplayReport report = engine.run(files);
+    EXPECT_EQ(report.files[0].trades, report.files[1].trades);
+    EXPECT_EQ(report.files[0].resting, report.files[1].resting);
+}
+
+TEST(ReplayEngine, ChecksumsLocateTheFirstDivergentEvent) {
+    const ReplayDirectory dir;
+    const std::string original = dir.write("original.csv", 7, 2'000);
+
+    // The same file with one New event's quantity changed.
+    auto events = OrderExecutor::getOrdersFromCsv(original);
+    std::size_t changed = 250;
+    while (events[changed].event != EventType::New) ++changed;
+    events[changed].quantity += 1;
+    {
+        std::ofstream file{dir.root / "changed.csv"};
+        for (const auto &e: events) file << e;
+    }
+
+    ReplayEngine engine{2};
+    engine.checksumEvery(100);
+    const ReplayReport report = engine.run(std::vector<std::string>{original, (dir.root / "changed.csv").string()});
+    ReplayEngine serial{1};
+    serial.checksumEvery(100);
+    const ReplayReport again = serial.run(std::vector<std::string>{original});
+
+    const FileReplay &a = report.files[0];
+    ASSERT_EQ(events.size() / 100, a.checksums.size());
+    EXPECT_EQ(std::nullopt, ReplayEngine::firstDivergence(a, again.files[0]));
+    EXPECT_EQ(again.files[0].finalHash, a.finalHash);
+    EXPECT_EQ((changed / 100 + 1) * 100, ReplayEngine::firstDivergence(a, report.files[1]));
+}
+
+TEST(ReplayEngine, MissingPathsThrow) {
+    const ReplayDirectory dir;
+    ReplayEngine engine{2};
+    EXPECT_THROW(ReplayEngine::listFiles((dir.root / "nothing").string()), std::runtime_error);
+    EXPECT_THROW((void)engine.run(std::vector<std::string>{(dir.root / "nothing.csv").string()}), std::runtime_error);
+}